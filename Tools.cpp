@@ -1,19 +1,20 @@
 #include "sorter.h"
+#include "search.h"
 /*
 // Data + containers utilities
     1. Sorter (templated) - DONE
         Use: Sort vectors/lists of numbers, strings, or custom structs (with a comparator).
         Steps: Accept container + comparator → choose algorithm (quick/merge/intro-lite) → sort → optionally return stable/unstable result.
 
-    2. Searcher (templated)
+    2. Searcher (templated) - DONE
         Use: Linear search (unsorted), binary search (sorted), and “find first matching predicate.”
         Steps: Accept container + target/predicate → pick search mode → scan or binary search → return index/iterator + “found” flag.
 
-    3. Uniq + Deduper
+    3. Uniq + Deduper - DONE
         Use: Remove duplicates from a container (sorted or unsorted).
         Steps: If unsorted: track seen keys → rebuild container; if sorted: sweep and skip repeats → return new size/result.
 
-    4. SetOps
+    4. SetOps - DONE
         Use: Union/intersection/difference of two containers.
         Steps: Normalize (sort or hash) → compute requested operation → output container.
 
@@ -21,15 +22,15 @@
         Use: Split a vector into fixed-size chunks (pagination, batch processing).
         Steps: Take container + chunk size → create subranges → return vector of slices/ranges.
 
-    6. RingBuffer
+    6. RingBuffer - DONE
         Use: Fixed-capacity buffer for streaming inputs (logs, sensor samples).
         Steps: Allocate capacity → push overwriting oldest when full → pop/peek → expose current size/order.
 
-    7. LRUCache (small)
+    7. LRUCache (small) - DONE
         Use: Cache computed values (parsing, expensive transforms).
         Steps: get(key) updates recency → put(key,val) evicts least-recently-used if full → maintain map + order.
 
-    8. FrequencyCounter
+    8. FrequencyCounter - DONE
         Use: Counts occurrences of items (words, IDs).
         Steps: Iterate inputs → increment counts → expose top-K / sorted frequencies / percent breakdown.
 
@@ -43,7 +44,7 @@
 
 // Strings + text processing
 
-    11. StringSplitter
+    11. StringSplitter - DONE
         Use: Split on delimiters, CSV-ish splitting (basic), trimming tokens.
         Steps: Scan string → detect delimiter boundaries → emit tokens → optional keep-empty → optional trim.
 
@@ -55,7 +56,7 @@
         Use: lower/upper/title/snake_case↔camelCase conversions.
         Steps: Scan chars → detect word boundaries → apply casing rules → rebuild.
 
-    14. FuzzyMatchLite
+    14. FuzzyMatchLite - DONE
         Use: “Did the user mean…?” for commands, names (typo tolerance).
         Steps: Normalize strings → compute simple distance score → pick best matches → threshold acceptance.
 
@@ -77,7 +78,7 @@
         Use: Join paths, normalize separators, extract filename/extension.
         Steps: Parse path → apply normalization rules → combine segments safely → return final path pieces.
 
-    19. FileLoader
+    19. FileLoader - DONE
         Use: Read entire file, read lines, write text file safely.
         Steps: Open → validate → read bytes/lines → close → return optional error status.
 
@@ -85,7 +86,7 @@
         Use: Lightweight key=value settings without bringing in a full parser.
         Steps: Read lines → ignore comments → split key/value → store typed getters (string/int/bool) → defaults.
 
-    21. CSVTableLite
+    21. CSVTableLite - DONE
         Use: Load/save basic CSV for small datasets.
         Steps: Read file → split rows/columns → store as vector<vector<string>> → allow column access → write out.
 
@@ -109,11 +110,11 @@
 
 // Logging + debugging utilities
 
-    26. Logger (levels + sinks)
+    26. Logger (levels + sinks) - DONE
         Use: Uniform logging without rewriting it each project.
         Steps: Define levels → write to console/file → timestamp + tag → filter by level → optional ring buffer.
 
-    27. Timer / ProfilerLite
+    27. Timer / ProfilerLite - DONE
         Use: Time code sections and report elapsed durations.
         Steps: Start/stop → compute duration → aggregate by label → print summary.
 
@@ -132,104 +133,6 @@
         Steps: Seed generator → provide randInt, randReal → implement shuffle → implement sample-K.
 */
 
-class Search {
-
-private:
-    // Compile using g++ -std=c++20 for span.
-    // Modified compareStrings function for Searching
-    bool compareStringsSearch(const std::string &a, const std::string &b) {
-        std::string A = a, B = b;
-        transform(A.begin(), A.end(), A.begin(), ::tolower);
-        transform(B.begin(), B.end(), B.begin(), ::tolower);
-
-        int sizeA = A.length();
-        int sizeB = B.length();
-        int sizeOp{};
-
-        if (sizeA > sizeB) {
-            return false;
-        }
-        else if (sizeA < sizeB) {
-            return false;
-        }
-
-        for (int i = 0; i < sizeOp; i++) {
-            if (A[i] == B[i]) {
-                continue;
-            }
-            else {
-                return false;
-            }
-        }
-    return true;
-    }
-
-public:
-    Search() = default;
-
-    // Binary Search
-    template <typename T, typename Value, typename Eq = std::equal_to<>>
-    void binarySearch(T& arr, const Value& x, Eq eq) const {
-        auto s = std::span(arr);
-        int low{};
-        int high = static_cast<int>(s.size()) - 1;
-        while (low <= high) {
-            int mid = low + (high - low) / 2;
-
-            // Check if x is present at mid
-            if (eq(s[mid], x)) {
-                std::cout << "found" << std::endl;
-                return;
-            }
-
-            // If x greater, ignore left half
-            if (s[mid] < x) {
-                low = mid + 1;
-            }
-
-            // If x is smaller, ignore right half
-            else {
-                high = mid - 1;
-            }
-        }
-
-        // If we reach here, then element was not present
-        std::cout << "nothing found" << std::endl;
-        return;
-    }
-
-    // Linear Search
-    template <typename T, typename Value, typename Eq>
-    void search(T& arr, const Value& x, Eq eq) const {
-        auto s = std::span(arr);
-        
-        // Iterate over the array in order to
-        // find the key x
-        for (size_t i = 0; i < s.size(); i++) {
-            if (eq(s[i], x)) {
-                std::cout << "found" << std::endl;
-                return;
-            }
-        }
-        std::cout << "not found" << std::endl;
-        return;
-    }
-
-    // Lambda for string searches
-    template <typename T>
-    void binarySearch_ci(T& v, std::string_view x) const {
-        this->binarySearch(v, x, [this](const std::string& a, const std::string& b) {
-            return compareStringsSearch(std::string_view(a), b);
-        });
-    }
-    template <typename T>
-    void search_ci(T& v, std::string_view x) const {
-        this->search(v, x, [this](const std::string& a, const std::string& b) {
-            return compareStringsSearch(std::string_view(a), b);
-        });
-    }
-};
-
 int main() {
     // TESTING /////
     // Object from Sorter.h
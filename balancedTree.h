@@ -0,0 +1,384 @@
+#pragma once
+#include <cstddef>      // std::size_t
+#include <cstdint>
+#include <functional>   // std::less
+#include <iterator>
+#include <type_traits>  // std::conditional_t
+#include <utility>      // std::pair, std::move, std::swap
+#include <vector>
+// NOT USING NAMESPACE STD FOR MORE ROBUST CODE
+
+/*
+BalancedTree (templated)
+    Use: The ordered version of binaryTree: key -> value map with guaranteed O(log n)
+         insert / find / erase, sorted iteration, lowerBound and range queries.
+    Steps: Keep the keys in binary search tree order (left < node < right by less) →
+           after every insert/erase walk back up to the root fixing heights →
+           rotate wherever the two sides differ by more than one (AVL).
+    Notes:
+        - Nodes live next to each other in one vector and point at each other with 32 bit
+          indices instead of pointers, so the whole tree is a handful of allocations and
+          copying/moving a tree is just copying/moving the vector.
+        - erase moves the last node into the hole to keep the vector packed, so insert/erase
+          invalidate iterators (like std::vector, unlike std::map).
+        - Iterating gives (key, value) pairs in key order: for (auto [k, v] : tree) ...
+        - Every node also knows its subtree size, so count(lo, hi) is two O(log n) descents
+          instead of a walk over the keys. range / count with hi < lo are empty.
+        - AVL keeps the height under 1.44 log2(n), a bit flatter than red-black, which
+          is what you want for a lookup heavy structure.
+*/
+
+template <typename Key, typename Value, typename Less = std::less<Key>>
+class BalancedTree {
+public:
+    using Index = std::uint32_t;
+    static constexpr Index nil = static_cast<Index>(-1);
+
+private:
+    struct Node {
+        Key key;
+        Value value;
+        Index left = nil;
+        Index right = nil;
+        Index parent = nil;
+        std::int32_t height = 1;
+        std::uint32_t size = 1;   // nodes in this subtree, for count()
+    };
+
+    std::vector<Node> nodes;
+    Index root = nil;
+    Less less;
+
+    std::int32_t heightOf(Index i) const { return i == nil ? 0 : nodes[i].height; }
+    std::uint32_t sizeOf(Index i) const { return i == nil ? 0 : nodes[i].size; }
+
+    // Height and subtree size from the two children
+    void updateHeight(Index i) {
+        std::int32_t l = heightOf(nodes[i].left), r = heightOf(nodes[i].right);
+        nodes[i].height = 1 + (l > r ? l : r);
+        nodes[i].size = 1 + sizeOf(nodes[i].left) + sizeOf(nodes[i].right);
+    }
+
+    // Subtree sizes on the path from i to the root change by one. retrace may stop
+    // early, so this walks the whole path first.
+    void addToPath(Index i, bool grow) {
+        for (; i != nil; i = nodes[i].parent) nodes[i].size = grow ? nodes[i].size + 1 : nodes[i].size - 1;
+    }
+
+    // Point whatever pointed at `from` (its parent or root) at `to`
+    void replaceChild(Index parent, Index from, Index to) {
+        if (parent == nil) root = to;
+        else if (nodes[parent].left == from) nodes[parent].left = to;
+        else nodes[parent].right = to;
+    }
+
+    // x with right child y becomes y with left child x, y's old left subtree moves under x
+    Index rotateLeft(Index x) {
+        Index y = nodes[x].right;
+        Index b = nodes[y].left;
+        nodes[x].right = b;
+        if (b != nil) nodes[b].parent = x;
+        nodes[y].parent = nodes[x].parent;
+        replaceChild(nodes[x].parent, x, y);
+        nodes[y].left = x;
+        nodes[x].parent = y;
+        updateHeight(x);
+        updateHeight(y);
+        return y;
+    }
+
+    // Mirror image of rotateLeft
+    Index rotateRight(Index x) {
+        Index y = nodes[x].left;
+        Index b = nodes[y].right;
+        nodes[x].left = b;
+        if (b != nil) nodes[b].parent = x;
+        nodes[y].parent = nodes[x].parent;
+        replaceChild(nodes[x].parent, x, y);
+        nodes[y].right = x;
+        nodes[x].parent = y;
+        updateHeight(x);
+        updateHeight(y);
+        return y;
+    }
+
+    // Fix one node, returns whatever is now at its spot
+    Index rebalance(Index i) {
+        updateHeight(i);
+        std::int32_t balance = heightOf(nodes[i].left) - heightOf(nodes[i].right);
+        if (balance > 1) {
+            Index l = nodes[i].left;
+            if (heightOf(nodes[l].left) < heightOf(nodes[l].right)) rotateLeft(l);   // left-right case
+            return rotateRight(i);
+        }
+        if (balance < -1) {
+            Index r = nodes[i].right;
+            if (heightOf(nodes[r].right) < heightOf(nodes[r].left)) rotateRight(r);  // right-left case
+            return rotateLeft(i);
+        }
+        return i;
+    }
+
+    // Walk up fixing heights and rotating where needed. Once a subtree comes out
+    // as tall as it was, nothing above it can change, so stop there.
+    void retrace(Index i) {
+        while (i != nil) {
+            std::int32_t before = nodes[i].height;
+            i = rebalance(i);
+            if (nodes[i].height == before) return;
+            i = nodes[i].parent;
+        }
+    }
+
+    Index minNode(Index i) const {
+        while (nodes[i].left != nil) i = nodes[i].left;
+        return i;
+    }
+    Index maxNode(Index i) const {
+        while (nodes[i].right != nil) i = nodes[i].right;
+        return i;
+    }
+
+    Index next(Index i) const {
+        if (nodes[i].right != nil) return minNode(nodes[i].right);
+        Index p = nodes[i].parent;
+        while (p != nil && nodes[p].right == i) {
+            i = p;
+            p = nodes[p].parent;
+        }
+        return p;
+    }
+    Index prev(Index i) const {
+        if (i == nil) return root == nil ? nil : maxNode(root);   // --end()
+        if (nodes[i].left != nil) return maxNode(nodes[i].left);
+        Index p = nodes[i].parent;
+        while (p != nil && nodes[p].left == i) {
+            i = p;
+            p = nodes[p].parent;
+        }
+        return p;
+    }
+
+    // One compare per level: find the lower bound, then check it once
+    Index findIndex(const Key& key) const {
+        Index i = lowerIndex(key);
+        return (i != nil && !less(key, nodes[i].key)) ? i : nil;
+    }
+
+    // First node with !(node < key), or nil
+    Index lowerIndex(const Key& key) const {
+        Index i = root, best = nil;
+        while (i != nil) {
+            if (less(nodes[i].key, key)) i = nodes[i].right;
+            else {
+                best = i;
+                i = nodes[i].left;
+            }
+        }
+        return best;
+    }
+
+    // Number of keys less than key, from the subtree sizes
+    std::size_t rankOf(const Key& key) const {
+        std::size_t r = 0;
+        Index i = root;
+        while (i != nil) {
+            if (less(nodes[i].key, key)) {
+                r += sizeOf(nodes[i].left) + 1;
+                i = nodes[i].right;
+            }
+            else i = nodes[i].left;
+        }
+        return r;
+    }
+
+    // First node with key < node, or nil
+    Index upperIndex(const Key& key) const {
+        Index i = root, best = nil;
+        while (i != nil) {
+            if (less(key, nodes[i].key)) {
+                best = i;
+                i = nodes[i].left;
+            }
+            else i = nodes[i].right;
+        }
+        return best;
+    }
+
+    // Moves the last node of the vector into slot `hole` and drops the last slot
+    void fillHole(Index hole) {
+        Index last = static_cast<Index>(nodes.size() - 1);
+        if (hole != last) {
+            nodes[hole] = std::move(nodes[last]);
+            Node& n = nodes[hole];
+            replaceChild(n.parent, last, hole);
+            if (n.left != nil) nodes[n.left].parent = hole;
+            if (n.right != nil) nodes[n.right].parent = hole;
+        }
+        nodes.pop_back();
+    }
+
+    template <bool Const>
+    class Iter {
+        using TreePtr = std::conditional_t<Const, const BalancedTree*, BalancedTree*>;
+        using ValueRef = std::conditional_t<Const, const Value&, Value&>;
+        TreePtr tree = nullptr;
+        Index i = nil;
+        friend class BalancedTree;
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = std::pair<const Key&, ValueRef>;
+        using reference = value_type;
+
+        Iter() = default;
+        Iter(TreePtr t, Index idx) : tree(t), i(idx) {}
+        operator Iter<true>() const requires (!Const) { return { tree, i }; }
+
+        const Key& key() const { return tree->nodes[i].key; }
+        ValueRef value() const { return tree->nodes[i].value; }
+        reference operator*() const { return { key(), value() }; }
+        Index index() const { return i; }
+
+        Iter& operator++() { i = tree->next(i); return *this; }
+        Iter operator++(int) { Iter t = *this; ++*this; return t; }
+        Iter& operator--() { i = tree->prev(i); return *this; }
+        Iter operator--(int) { Iter t = *this; --*this; return t; }
+
+        bool operator==(const Iter& o) const { return i == o.i; }
+    };
+
+public:
+    using iterator = Iter<false>;
+    using const_iterator = Iter<true>;
+
+    // begin/end pair so a range query works in a range-for
+    template <typename It>
+    struct Range {
+        It first;
+        It last;
+        It begin() const { return first; }
+        It end() const { return last; }
+        bool empty() const { return first == last; }
+    };
+
+    BalancedTree() = default;
+    explicit BalancedTree(Less l) : less(l) {}
+
+    std::size_t size() const { return nodes.size(); }
+    bool empty() const { return nodes.empty(); }
+    int height() const { return heightOf(root); }
+    void clear() { nodes.clear(); root = nil; }
+    void reserve(std::size_t n) { nodes.reserve(n); }
+
+    iterator begin() { return { this, root == nil ? nil : minNode(root) }; }
+    iterator end() { return { this, nil }; }
+    const_iterator begin() const { return { this, root == nil ? nil : minNode(root) }; }
+    const_iterator end() const { return { this, nil }; }
+
+    // Adds key -> value if key is not there yet. Returns where the key is and whether it was added.
+    std::pair<iterator, bool> insert(const Key& key, Value value) {
+        // Same one compare per level as findIndex: remember the last node we went right at
+        // (the biggest key <= key on the path), it is the only one that can be equal
+        Index parent = nil, i = root, notGreater = nil;
+        bool goLeft = false;
+        while (i != nil) {
+            parent = i;
+            goLeft = less(key, nodes[i].key);
+            if (goLeft) i = nodes[i].left;
+            else {
+                notGreater = i;
+                i = nodes[i].right;
+            }
+        }
+        if (notGreater != nil && !less(nodes[notGreater].key, key)) return { iterator(this, notGreater), false };
+
+        Index added = static_cast<Index>(nodes.size());
+        nodes.push_back(Node{ key, std::move(value), nil, nil, parent, 1, 1 });
+        if (parent == nil) root = added;
+        else if (goLeft) nodes[parent].left = added;
+        else nodes[parent].right = added;
+        addToPath(parent, true);
+        retrace(parent);
+        return { iterator(this, added), true };
+    }
+
+    // Like insert, but overwrites the value of an existing key
+    std::pair<iterator, bool> insertOrAssign(const Key& key, Value value) {
+        Index i = findIndex(key);
+        if (i != nil) {
+            nodes[i].value = std::move(value);
+            return { iterator(this, i), false };
+        }
+        return insert(key, std::move(value));
+    }
+
+    Value& operator[](const Key& key) {
+        Index i = findIndex(key);
+        if (i == nil) i = insert(key, Value{}).first.i;
+        return nodes[i].value;
+    }
+
+    // Removes key if it is there. Returns how many were removed (0 or 1).
+    std::size_t erase(const Key& key) {
+        Index z = findIndex(key);
+        if (z == nil) return 0;
+
+        // Two children: swap in the successor, which has no left child, and remove that slot instead
+        if (nodes[z].left != nil && nodes[z].right != nil) {
+            Index s = minNode(nodes[z].right);
+            std::swap(nodes[z].key, nodes[s].key);
+            std::swap(nodes[z].value, nodes[s].value);
+            z = s;
+        }
+
+        Index child = nodes[z].left != nil ? nodes[z].left : nodes[z].right;
+        Index parent = nodes[z].parent;
+        if (child != nil) nodes[child].parent = parent;
+        replaceChild(parent, z, child);
+
+        Index last = static_cast<Index>(nodes.size() - 1);
+        fillHole(z);
+        if (parent == last) parent = z;   // the parent was the node that got moved
+        addToPath(parent, false);
+        retrace(parent);
+        return 1;
+    }
+
+    iterator find(const Key& key) { return { this, findIndex(key) }; }
+    const_iterator find(const Key& key) const { return { this, findIndex(key) }; }
+    bool contains(const Key& key) const { return findIndex(key) != nil; }
+
+    // Pointer to the value or nullptr, for a quick lookup without iterators
+    Value* get(const Key& key) {
+        Index i = findIndex(key);
+        return i == nil ? nullptr : &nodes[i].value;
+    }
+    const Value* get(const Key& key) const {
+        Index i = findIndex(key);
+        return i == nil ? nullptr : &nodes[i].value;
+    }
+
+    // First key not less than key / first key greater than key
+    iterator lowerBound(const Key& key) { return { this, lowerIndex(key) }; }
+    const_iterator lowerBound(const Key& key) const { return { this, lowerIndex(key) }; }
+    iterator upperBound(const Key& key) { return { this, upperIndex(key) }; }
+    const_iterator upperBound(const Key& key) const { return { this, upperIndex(key) }; }
+
+    // Keys in [lo, hi), in order. Empty when hi < lo.
+    Range<iterator> range(const Key& lo, const Key& hi) {
+        iterator first = lowerBound(lo);
+        return { first, less(hi, lo) ? first : lowerBound(hi) };
+    }
+    Range<const_iterator> range(const Key& lo, const Key& hi) const {
+        const_iterator first = lowerBound(lo);
+        return { first, less(hi, lo) ? first : lowerBound(hi) };
+    }
+
+    // Number of keys in [lo, hi) (0 when hi < lo), O(log n) from the subtree sizes
+    std::size_t count(const Key& lo, const Key& hi) const {
+        if (!less(lo, hi)) return 0;
+        return rankOf(hi) - rankOf(lo);
+    }
+};
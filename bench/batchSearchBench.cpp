@@ -0,0 +1,65 @@
+#include "../search.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+/*
+    Batched lookup benchmark
+    Use: Look up a batch of random keys in sorted ints, one Search::binaryFind call per key
+         vs one Search::binaryFindBatch call (unsorted and sorted keys) and
+         SearchIndex::lowerBound per key vs SearchIndex::lowerBoundBatch.
+    Build: g++ -std=c++20 -O2 bench/batchSearchBench.cpp -o batchSearchBench
+    Run:   ./batchSearchBench [max size] [queries]   (default 64000000, 1000000)
+*/
+
+template <typename F>
+static double nsPerKey(std::size_t keys, F f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / static_cast<double>(keys);
+}
+
+int main(int argc, char** argv) {
+    std::size_t maxSize = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 64000000;
+    std::size_t queryCount = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+
+    std::mt19937 rng(5);
+    Search search;
+
+    std::printf("%12s %12s %12s %9s %12s %12s %12s %9s\n", "n", "binaryFind", "batch", "speedup",
+                "batch sorted", "index", "index batch", "speedup");
+    for (std::size_t n = 1000; n <= maxSize; n *= 4) {
+        std::vector<int> data(n);
+        for (std::size_t i = 0; i < n; ++i) data[i] = static_cast<int>(2 * i);
+        SearchIndex index(data);
+
+        std::vector<int> queries(queryCount);
+        for (int& q : queries) q = static_cast<int>(rng() % (2 * n));
+        std::vector<int> sortedQueries = queries;
+        std::sort(sortedQueries.begin(), sortedQueries.end());
+
+        std::vector<std::size_t> scalar(queryCount), batch(queryCount), sorted(queryCount), viaIndex(queryCount), indexBatch(queryCount);
+        double scalarNs = nsPerKey(queryCount, [&] {
+            for (std::size_t i = 0; i < queryCount; ++i) scalar[i] = search.binaryFind(data, queries[i]).index;
+        });
+        double batchNs  = nsPerKey(queryCount, [&] { search.binaryFindBatch(data, queries, batch); });
+        double sortedNs = nsPerKey(queryCount, [&] { search.binaryFindBatch(data, sortedQueries, sorted); });
+        double indexNs  = nsPerKey(queryCount, [&] {
+            for (std::size_t i = 0; i < queryCount; ++i) viaIndex[i] = index.lowerBound(queries[i]);
+        });
+        double indexBatchNs = nsPerKey(queryCount, [&] { index.lowerBoundBatch(queries, indexBatch); });
+
+        std::vector<std::size_t> scalarSorted(queryCount);   // checks the sorted (galloping sweep) path
+        for (std::size_t i = 0; i < queryCount; ++i) scalarSorted[i] = search.binaryFind(data, sortedQueries[i]).index;
+        if (scalar != batch || scalar != viaIndex || scalar != indexBatch || scalarSorted != sorted) {
+            std::fprintf(stderr, "batched lookups disagree with binaryFind\n");
+            return 1;
+        }
+        std::printf("%12zu %9.1f ns %9.1f ns %8.2fx %9.1f ns %9.1f ns %9.1f ns %8.2fx\n", n, scalarNs, batchNs,
+                    scalarNs / batchNs, sortedNs, indexNs, indexBatchNs, indexNs / indexBatchNs);
+    }
+    return 0;
+}
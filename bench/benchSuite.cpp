@@ -0,0 +1,329 @@
+#include "../sorter.h"
+#include "../search.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <random>
+
+/*
+    Benchmark suite for Sorter and Search
+    Use: Sweep sizes, element types and input distributions through the silent
+         (non printing) Sorter and Search calls and report, per element:
+            - time (ns/elem for sorts, ns/lookup for searches)
+            - comparisons and moves (counted on a rerun with an instrumented element type,
+              which always takes the comparison engines, never the radix ones)
+            - heap allocations made during the timed run
+         Output is a human readable table on stdout and, with --csv, a CSV file.
+    Build: g++ -std=c++20 -O2 -pthread bench/benchSuite.cpp -o benchSuite
+    Run:   ./benchSuite [--min N] [--max N] [--types int,double,string,large]
+                        [--dists random,sorted,reverse,organ,few,nearly] [--csv file]
+           Sizes go up by 10x from --min (default 1e3) to --max (default 1e6, up to 1e8 works
+           if the box has the memory: 1e8 strings need around 10 GB).
+*/
+
+// ---------------- allocation counting ----------------
+static std::atomic<std::size_t> allocationCount{0};
+
+// GCC can't tell that these replace the global new/delete pair and warns about malloc/free
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void* operator new(std::size_t n) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+#pragma GCC diagnostic pop
+
+// ---------------- element types ----------------
+// A "large struct": 8 byte key plus 120 bytes of payload that has to travel with it
+struct Large {
+    std::uint64_t key;
+    char payload[120];
+
+    friend bool operator<(const Large& a, const Large& b) { return a.key < b.key; }
+    friend bool operator==(const Large& a, const Large& b) { return a.key == b.key; }
+};
+
+// Counts every compare and move/copy. Single threaded only.
+static std::size_t comparisonCount = 0;
+static std::size_t moveCount = 0;
+
+template <typename T>
+struct Tracked {
+    T value;
+
+    Tracked() = default;
+    explicit Tracked(T v) : value(std::move(v)) {}
+    Tracked(const Tracked& o) : value(o.value) { ++moveCount; }
+    Tracked(Tracked&& o) noexcept : value(std::move(o.value)) { ++moveCount; }
+    Tracked& operator=(const Tracked& o) { value = o.value; ++moveCount; return *this; }
+    Tracked& operator=(Tracked&& o) noexcept { value = std::move(o.value); ++moveCount; return *this; }
+
+    friend bool operator<(const Tracked& a, const Tracked& b) { ++comparisonCount; return a.value < b.value; }
+    friend bool operator==(const Tracked& a, const Tracked& b) { ++comparisonCount; return a.value == b.value; }
+};
+
+template <typename T>
+static T makeValue(std::uint64_t k) {
+    if constexpr (std::is_same_v<T, int>) {
+        return static_cast<int>(k);
+    }
+    else if constexpr (std::is_same_v<T, double>) {
+        return static_cast<double>(static_cast<std::int64_t>(k)) * 0.5;
+    }
+    else if constexpr (std::is_same_v<T, std::string>) {
+        char buf[32];
+        std::snprintf(buf, sizeof buf, "key_%016llx", static_cast<unsigned long long>(k));   // keeps k's order
+        return buf;
+    }
+    else {
+        Large l;
+        l.key = k;
+        std::memset(l.payload, static_cast<int>(k & 0xFF), sizeof l.payload);
+        return l;
+    }
+}
+
+// ---------------- input distributions ----------------
+enum class Dist { Random, Sorted, Reverse, OrganPipe, FewUnique, NearlySorted };
+
+static const char* distName(Dist d) {
+    switch (d) {
+        case Dist::Random:       return "random";
+        case Dist::Sorted:       return "sorted";
+        case Dist::Reverse:      return "reverse";
+        case Dist::OrganPipe:    return "organ";
+        case Dist::FewUnique:    return "few";
+        case Dist::NearlySorted: return "nearly";
+    }
+    return "?";
+}
+
+// Keys are kept below 2^31 so every type sees the same order
+static std::vector<std::uint64_t> makeKeys(Dist d, std::size_t n, std::mt19937_64& rng) {
+    std::vector<std::uint64_t> k(n);
+    const std::uint64_t mask = 0x7FFFFFFF;
+    for (std::size_t i = 0; i < n; ++i) {
+        switch (d) {
+            case Dist::Random:       k[i] = rng() & mask; break;
+            case Dist::Sorted:
+            case Dist::NearlySorted: k[i] = i; break;
+            case Dist::Reverse:      k[i] = n - i; break;
+            case Dist::OrganPipe:    k[i] = i < n / 2 ? i : n - i; break;
+            case Dist::FewUnique:    k[i] = rng() % 16; break;
+        }
+    }
+    if (d == Dist::NearlySorted) {
+        for (std::size_t i = 0; i < n / 100; ++i) std::swap(k[rng() % n], k[rng() % n]);   // 1% out of place
+    }
+    return k;
+}
+
+// ---------------- reporting ----------------
+struct Row {
+    const char* kind;       // "sort" or "search"
+    const char* type;
+    const char* dist;
+    std::size_t n;
+    const char* algo;
+    const char* engine;
+    double nsPerItem;
+    double cmpPerItem;
+    double movesPerItem;
+    std::size_t allocs;
+};
+
+static std::FILE* csv = nullptr;
+
+static void report(const Row& r) {
+    std::printf("%-6s %-7s %-7s %10zu %-18s %-18s %10.2f %10.2f %10.2f %8zu\n", r.kind, r.type, r.dist, r.n,
+                r.algo, r.engine, r.nsPerItem, r.cmpPerItem, r.movesPerItem, r.allocs);
+    if (csv) {
+        std::fprintf(csv, "%s,%s,%s,%zu,%s,%s,%.3f,%.3f,%.3f,%zu\n", r.kind, r.type, r.dist, r.n,
+                     r.algo, r.engine, r.nsPerItem, r.cmpPerItem, r.movesPerItem, r.allocs);
+    }
+}
+
+// ---------------- measurements ----------------
+struct Timed {
+    double ns;
+    std::size_t allocs;
+};
+
+template <typename F>
+static Timed timeIt(F f) {
+    std::size_t a0 = allocationCount.load();
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto stop = std::chrono::steady_clock::now();
+    return { std::chrono::duration<double, std::nano>(stop - start).count(), allocationCount.load() - a0 };
+}
+
+template <typename T>
+static bool isSorted(const std::vector<T>& v) {
+    for (std::size_t i = 1; i < v.size(); ++i) {
+        if (v[i] < v[i - 1]) return false;
+    }
+    return true;
+}
+
+// Sort on a fresh copy with raw T (timed), then again with Tracked<T> (counted)
+template <typename T, typename SortRaw, typename SortTracked>
+static void sortRow(const char* type, Dist d, const std::vector<std::uint64_t>& keys, const char* algo,
+                    SortRaw sortRaw, SortTracked sortTracked) {
+    std::size_t n = keys.size();
+
+    std::vector<T> raw;
+    raw.reserve(n);
+    for (std::uint64_t k : keys) raw.push_back(makeValue<T>(k));
+    const char* engine = "-";
+    Timed t = timeIt([&] { engine = sortRaw(raw); });
+    if (!isSorted(raw)) {
+        std::fprintf(stderr, "%s did not sort %s/%s\n", algo, type, distName(d));
+        std::exit(1);
+    }
+    raw = {};
+
+    std::vector<Tracked<T>> tracked;
+    tracked.reserve(n);
+    for (std::uint64_t k : keys) tracked.emplace_back(makeValue<T>(k));
+    comparisonCount = 0;
+    moveCount = 0;
+    sortTracked(tracked);
+
+    double dn = static_cast<double>(n);
+    report({ "sort", type, distName(d), n, algo, engine, t.ns / dn,
+             static_cast<double>(comparisonCount) / dn, static_cast<double>(moveCount) / dn, t.allocs });
+}
+
+template <typename T>
+static void searchRows(const char* type, const std::vector<std::uint64_t>& keys, std::mt19937_64& rng) {
+    Search search;
+    std::size_t n = keys.size();
+
+    std::vector<T> data;
+    data.reserve(n);
+    for (std::uint64_t k : keys) data.push_back(makeValue<T>(k));
+    std::vector<Tracked<T>> tracked;
+    tracked.reserve(n);
+    for (std::uint64_t k : keys) tracked.emplace_back(makeValue<T>(k));
+
+    // Linear scans get fewer queries so big sizes finish
+    std::size_t linearQueries = std::max<std::size_t>(1, 10000000 / n);
+    std::size_t binaryQueries = 1000000;
+    std::vector<T> queries;
+    std::vector<Tracked<T>> trackedQueries;
+    for (std::size_t q = 0; q < std::max(linearQueries, binaryQueries); ++q) {
+        std::uint64_t k = keys[rng() % n];
+        queries.push_back(makeValue<T>(k));
+        trackedQueries.emplace_back(makeValue<T>(k));
+    }
+
+    std::size_t hits = 0;
+    Timed lin = timeIt([&] {
+        for (std::size_t q = 0; q < linearQueries; ++q) hits += search.find(data, queries[q]).found;
+    });
+    comparisonCount = 0;
+    for (std::size_t q = 0; q < linearQueries; ++q) hits += search.find(tracked, trackedQueries[q]).found;
+    report({ "search", type, "random", n, "find", "linear", lin.ns / linearQueries,
+             static_cast<double>(comparisonCount) / linearQueries, 0, lin.allocs });
+
+    Sorter sorter;
+    sorter.introsort(data);
+    sorter.introsort(tracked);
+    Timed bin = timeIt([&] {
+        for (std::size_t q = 0; q < binaryQueries; ++q) hits += search.binaryFind(data, queries[q]).found;
+    });
+    comparisonCount = 0;
+    for (std::size_t q = 0; q < binaryQueries; ++q) hits += search.binaryFind(tracked, trackedQueries[q]).found;
+    report({ "search", type, "sorted", n, "binaryFind", "binary", bin.ns / binaryQueries,
+             static_cast<double>(comparisonCount) / binaryQueries, 0, bin.allocs });
+
+    if (hits != 2 * (linearQueries + binaryQueries)) {
+        std::fprintf(stderr, "search missed a key that is in the data\n");
+        std::exit(1);
+    }
+}
+
+template <typename T>
+static void runType(const char* type, std::size_t minSize, std::size_t maxSize,
+                    const std::vector<Dist>& dists, std::mt19937_64& rng) {
+    Sorter sorter;
+    for (std::size_t n = minSize; n <= maxSize; n *= 10) {
+        for (Dist d : dists) {
+            std::vector<std::uint64_t> keys = makeKeys(d, n, rng);
+            sortRow<T>(type, d, keys, "Sorter::introsort",
+                       [&](std::vector<T>& v) { return sorter.introsort(v).engine; },
+                       [&](std::vector<Tracked<T>>& v) { sorter.introsort(v); });
+            sortRow<T>(type, d, keys, "Sorter::stablesort",
+                       [&](std::vector<T>& v) { return sorter.stablesort(v).engine; },
+                       [&](std::vector<Tracked<T>>& v) { sorter.stablesort(v); });
+            sortRow<T>(type, d, keys, "std::sort",
+                       [](std::vector<T>& v) { std::sort(v.begin(), v.end()); return "std"; },
+                       [](std::vector<Tracked<T>>& v) { std::sort(v.begin(), v.end()); });
+            sortRow<T>(type, d, keys, "std::stable_sort",
+                       [](std::vector<T>& v) { std::stable_sort(v.begin(), v.end()); return "std"; },
+                       [](std::vector<Tracked<T>>& v) { std::stable_sort(v.begin(), v.end()); });
+        }
+        searchRows<T>(type, makeKeys(Dist::Random, n, rng), rng);
+    }
+}
+
+static bool listed(const char* list, const char* name) {
+    if (list == nullptr) return true;
+    std::string l = std::string(",") + list + ",";
+    return l.find(std::string(",") + name + ",") != std::string::npos;
+}
+
+int main(int argc, char** argv) {
+    std::size_t minSize = 1000, maxSize = 1000000;
+    const char* types = nullptr;
+    const char* distList = nullptr;
+    const char* csvPath = nullptr;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string flag = argv[i];
+        if (flag == "--min")        minSize = static_cast<std::size_t>(std::strtod(argv[i + 1], nullptr));
+        else if (flag == "--max")   maxSize = static_cast<std::size_t>(std::strtod(argv[i + 1], nullptr));
+        else if (flag == "--types") types = argv[i + 1];
+        else if (flag == "--dists") distList = argv[i + 1];
+        else if (flag == "--csv")   csvPath = argv[i + 1];
+        else {
+            std::fprintf(stderr, "unknown flag %s\n", argv[i]);
+            return 1;
+        }
+    }
+    if (minSize == 0) minSize = 1;
+
+    std::vector<Dist> dists;
+    for (Dist d : { Dist::Random, Dist::Sorted, Dist::Reverse, Dist::OrganPipe, Dist::FewUnique, Dist::NearlySorted }) {
+        if (listed(distList, distName(d))) dists.push_back(d);
+    }
+
+    if (csvPath) {
+        csv = std::fopen(csvPath, "w");
+        if (!csv) {
+            std::fprintf(stderr, "can't open %s\n", csvPath);
+            return 1;
+        }
+        std::fprintf(csv, "kind,type,dist,n,algo,engine,ns_per_item,cmp_per_item,moves_per_item,allocs\n");
+    }
+
+    std::printf("%-6s %-7s %-7s %10s %-18s %-18s %10s %10s %10s %8s\n", "kind", "type", "dist", "n",
+                "algo", "engine", "ns/item", "cmp/item", "moves/item", "allocs");
+
+    std::mt19937_64 rng(2024);
+    if (listed(types, "int"))    runType<int>("int", minSize, maxSize, dists, rng);
+    if (listed(types, "double")) runType<double>("double", minSize, maxSize, dists, rng);
+    if (listed(types, "string")) runType<std::string>("string", minSize, maxSize, dists, rng);
+    if (listed(types, "large"))  runType<Large>("large", minSize, maxSize, dists, rng);
+
+    if (csv) std::fclose(csv);
+    return 0;
+}
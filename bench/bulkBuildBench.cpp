@@ -0,0 +1,52 @@
+#include "../binaryTree.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+
+/*
+    binaryTree bulk load benchmark
+    Use: Loading sorted keys with n insertNode calls vs buildFromSorted (one thread and a
+         ThreadPool), plus insertSorted of a second batch of n/10 sorted keys.
+    Build: g++ -std=c++20 -O2 -pthread bench/bulkBuildBench.cpp -o bulkBuildBench
+    Run:   ./bulkBuildBench [max size] [threads]   (default 10000000, hardware threads)
+*/
+
+template <typename F>
+static double msFor(F f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    std::size_t maxSize = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    std::size_t threadCount = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 0;
+    if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+    ThreadPool threads(threadCount - 1);   // plus the calling thread
+    std::mt19937 rng(13);
+
+    std::printf("%10s %14s %14s %14s %16s\n", "n", "insertNode", "buildFromSorted", "parallel", "insertSorted n/10");
+    for (std::size_t n = 1000; n <= maxSize; n *= 10) {
+        std::vector<int> keys(n), batch(n / 10);
+        for (int& k : keys) k = static_cast<int>(rng());
+        for (int& k : batch) k = static_cast<int>(rng());
+        Sorter().introsort(keys);
+        Sorter().introsort(batch);
+
+        char one[32] = "-";
+        if (n <= 10000) {
+            binaryTree tree;
+            std::snprintf(one, sizeof(one), "%.2f ms", msFor([&] { for (int k : keys) tree.insertNode(k); }));
+        }
+        binaryTree bulk, par;
+        double bulkMs = msFor([&] { bulk.buildFromSorted(keys); });
+        double parMs = msFor([&] { par.buildFromSorted(keys, threads); });
+        double mergeMs = msFor([&] { bulk.insertSorted(batch); });
+        std::printf("%10zu %14s %11.2f ms %11.2f ms %13.2f ms\n", n, one, bulkMs, parMs, mergeMs);
+    }
+    std::printf("(%zu threads)\n", threadCount);
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include "../sorter.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+/*
+    Case insensitive sort benchmark
+    Use: Compare the old lower-case-on-every-compare approach with the CaseFold
+         compare and with sortByKey (fold once per element), next to a plain
+         case sensitive sort of the same data.
+    Build: g++ -std=c++20 -O2 bench/caseFoldBench.cpp -o caseFoldBench
+    Run:   ./caseFoldBench [n]   (default 1000000)
+*/
+
+// What quicksort_ci/msort_ci used to do: two copies + two transforms per compare
+static bool lowerEveryCompare(const std::string& a, const std::string& b) {
+    std::string A = a, B = b;
+    std::transform(A.begin(), A.end(), A.begin(), ::tolower);
+    std::transform(B.begin(), B.end(), B.begin(), ::tolower);
+    return A < B;
+}
+
+template <typename F>
+static double nsPerElement(const std::vector<std::string>& input, F f) {
+    std::vector<std::string> v = input;
+    auto start = std::chrono::steady_clock::now();
+    f(v);
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / static_cast<double>(input.size());
+}
+
+int main(int argc, char** argv) {
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    std::mt19937 rng(7);
+    const char letters[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    std::vector<std::string> input(n);
+    for (std::string& s : input) {
+        std::size_t len = 8 + rng() % 24;   // past the small string buffer for most keys
+        for (std::size_t i = 0; i < len; ++i) s += letters[rng() % 52];
+    }
+
+    Sorter sorter;
+    auto caseSensitive = [](const std::string& a, const std::string& b) { return a < b; };
+    auto fold = [](const std::string& s) { return CaseFold::lower(s); };
+
+    double plain   = nsPerElement(input, [&](auto& v) { sorter.introsort(v, caseSensitive); });
+    double old     = nsPerElement(input, [&](auto& v) { sorter.introsort(v, lowerEveryCompare); });
+    double cmp     = nsPerElement(input, [&](auto& v) { sorter.introsort(v, CaseFold::Less{}); });
+    double keyed   = nsPerElement(input, [&](auto& v) { sorter.sortByKey(v, fold); });
+    double stableK = nsPerElement(input, [&](auto& v) { sorter.stableSortByKey(v, fold); });
+
+    std::printf("n = %zu strings\n", n);
+    std::printf("%-34s %10.1f ns/elem  %5.2fx\n", "case sensitive introsort", plain, 1.0);
+    std::printf("%-34s %10.1f ns/elem  %5.2fx\n", "lower case on every compare (old)", old, old / plain);
+    std::printf("%-34s %10.1f ns/elem  %5.2fx\n", "CaseFold::Less", cmp, cmp / plain);
+    std::printf("%-34s %10.1f ns/elem  %5.2fx\n", "sortByKey (quicksort_ci)", keyed, keyed / plain);
+    std::printf("%-34s %10.1f ns/elem  %5.2fx\n", "stableSortByKey (msort_ci)", stableK, stableK / plain);
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include "../concurrentTree.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <thread>
+
+/*
+    Concurrent binaryTree benchmark
+    Use: Operations per second at a 99:1 search:write mix for 1..N threads, comparing
+         binaryTree behind one std::mutex, behind a std::shared_mutex and ConcurrentTree.
+         Writes alternate insertNode/deleteNode of keys that are not in the tree,
+         searches look for random keys that are.
+    Build: g++ -std=c++20 -O2 -pthread bench/concurrentTreeBench.cpp -o concurrentTreeBench
+    Run:   ./concurrentTreeBench [tree size] [max threads] [ms per run]   (default 20000, 2 x hardware, 500)
+*/
+
+struct MutexTree {
+    binaryTree tree;
+    std::mutex mtx;
+    bool search(int v) { std::lock_guard<std::mutex> l(mtx); return tree.search(v); }
+    void insertNode(int v) { std::lock_guard<std::mutex> l(mtx); tree.insertNode(v); }
+    void deleteNode(int v) { std::lock_guard<std::mutex> l(mtx); tree.deleteNode(v); }
+};
+
+struct SharedMutexTree {
+    binaryTree tree;
+    std::shared_mutex mtx;
+    bool search(int v) { std::shared_lock<std::shared_mutex> l(mtx); return tree.search(v); }
+    void insertNode(int v) { std::unique_lock<std::shared_mutex> l(mtx); tree.insertNode(v); }
+    void deleteNode(int v) { std::unique_lock<std::shared_mutex> l(mtx); tree.deleteNode(v); }
+};
+
+// Total operations per second with `threads` threads hammering t for ms milliseconds
+template <typename T>
+static double opsPerSecond(T& t, std::size_t threads, int keys, int ms) {
+    std::atomic<bool> stop{false};
+    std::atomic<long long> total{0};
+    std::vector<std::thread> workers;
+    for (std::size_t w = 0; w < threads; ++w) {
+        workers.emplace_back([&, w] {
+            std::mt19937 rng(static_cast<unsigned>(w) + 1);
+            long long ops = 0, found = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (rng() % 100 == 0) {
+                    int odd = 2 * static_cast<int>(rng() % static_cast<unsigned>(keys)) + 1;
+                    if (ops & 1) t.insertNode(odd);
+                    else t.deleteNode(odd);
+                }
+                else {
+                    found += t.search(2 * static_cast<int>(rng() % static_cast<unsigned>(keys)));
+                }
+                ++ops;
+            }
+            if (found < 0) std::abort();
+            total += ops;
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    stop = true;
+    for (std::thread& th : workers) th.join();
+    return static_cast<double>(total.load()) * 1000.0 / ms;
+}
+
+int main(int argc, char** argv) {
+    int keys = argc > 1 ? std::atoi(argv[1]) : 20000;
+    std::size_t maxThreads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 2 * std::thread::hardware_concurrency();
+    int ms = argc > 3 ? std::atoi(argv[3]) : 500;
+
+    std::vector<int> even(static_cast<std::size_t>(keys));
+    for (int i = 0; i < keys; ++i) even[static_cast<std::size_t>(i)] = 2 * i;
+
+    std::printf("binaryTree with %d keys, 99%% search / 1%% insert+delete, ops per second\n", keys);
+    std::printf("%8s %14s %14s %14s %9s\n", "threads", "std::mutex", "shared_mutex", "ConcurrentTree", "vs mutex");
+    for (std::size_t threads = 1; threads <= maxThreads; threads *= 2) {
+        MutexTree m;
+        m.tree.buildFromSorted(even);
+        SharedMutexTree sm;
+        sm.tree.buildFromSorted(even);
+        ConcurrentTree<> ct{ binaryTree(even) };
+
+        double mOps = opsPerSecond(m, threads, keys, ms);
+        double smOps = opsPerSecond(sm, threads, keys, ms);
+        double ctOps = opsPerSecond(ct, threads, keys, ms);
+        std::printf("%8zu %14.0f %14.0f %14.0f %8.2fx\n", threads, mOps, smOps, ctOps, ctOps / mOps);
+    }
+    std::printf("(%u hardware threads)\n", std::thread::hardware_concurrency());
+    return 0;
+}
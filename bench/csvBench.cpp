@@ -0,0 +1,101 @@
+#include "../csvTableLite.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*
+    CSV / StringSplitter benchmark
+    Use: GB/s for reading a generated CSV (ids, prices, short names, some quoted fields with
+         commas) the std way (getline + vector<vector<string>>), with StringSplitter
+         (lines + split into string_views), and with CSVTableLite serial and parallel.
+    Build: g++ -std=c++20 -O2 -pthread bench/csvBench.cpp -o csvBench
+    Run:   ./csvBench [megabytes] [threads]   (default 256, hardware threads)
+*/
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+static double secondsFor(F f) {
+    auto start = Clock::now();
+    f();
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+static std::string makeCsv(std::size_t bytes) {
+    static const char* names[] = { "alice", "bob", "carol", "dave", "erin", "frank", "grace", "heidi" };
+    std::mt19937_64 rng(7);
+    std::string s = "id,price,qty,name,city,note\n";
+    s.reserve(bytes + 256);
+    for (std::size_t row = 0; s.size() < bytes; ++row) {
+        s += std::to_string(row);
+        s += ',';
+        s += std::to_string(rng() % 100000 / 100.0);
+        s += ',';
+        s += std::to_string(rng() % 50);
+        s += ',';
+        s += names[rng() % 8];
+        s += ',';
+        s += rng() % 4 ? "Berlin" : "\"Washington, D.C.\"";
+        s += ',';
+        s += rng() % 10 ? "" : "\"said \"\"ok\"\"\"";
+        s += '\n';
+    }
+    return s;
+}
+
+int main(int argc, char** argv) {
+    std::size_t mb = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 256;
+    std::size_t threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 0;
+    std::string csv = makeCsv(mb << 20);
+    double gb = static_cast<double>(csv.size()) / 1e9;
+    std::printf("%.1f MB of CSV\n\n", static_cast<double>(csv.size()) / 1e6);
+
+    std::size_t check = 0;
+    double t = secondsFor([&] {
+        std::istringstream in(csv);
+        std::vector<std::vector<std::string>> table;
+        std::string line, field;
+        while (std::getline(in, line)) {
+            std::vector<std::string> row;
+            std::istringstream fields(line);
+            while (std::getline(fields, field, ',')) row.push_back(field);
+            table.push_back(std::move(row));
+        }
+        check += table.size();
+    });
+    std::printf("%-34s %7.3f GB/s  (ignores quoting)\n", "getline + vector<vector<string>>", gb / t);
+
+    t = secondsFor([&] {
+        std::vector<std::string_view> fields;
+        StringSplitter::forEachLine(csv, [&](std::string_view line) { check += StringSplitter::split(line, ',', fields); });
+    });
+    std::printf("%-34s %7.3f GB/s  (ignores quoting)\n", "StringSplitter lines + split", gb / t);
+
+    t = secondsFor([&] { check += ByteScan::count(csv.data(), csv.size(), '\n'); });
+    std::printf("%-34s %7.3f GB/s\n", "ByteScan::count newlines", gb / t);
+
+    CSVTableLite serial;
+    t = secondsFor([&] { serial.parse(csv); });
+    std::printf("%-34s %7.3f GB/s  %zu rows, %.1f MB of fields\n", "CSVTableLite parse", gb / t, serial.rows(),
+                static_cast<double>(serial.bytes()) / 1e6);
+
+    CSVTableLite parallel;
+    t = secondsFor([&] { parallel.parseParallel(csv, {}, threads); });
+    std::printf("%-34s %7.3f GB/s  %zu rows\n", "CSVTableLite parseParallel", gb / t, parallel.rows());
+
+    if (serial.rows() != parallel.rows() || serial.at(serial.rows() / 2, 4) != parallel.at(parallel.rows() / 2, 4)) {
+        std::fprintf(stderr, "parallel parse disagrees with serial\n");
+        return 1;
+    }
+    std::size_t city = serial.columnIndex("city");
+    std::size_t dc = 0;
+    t = secondsFor([&] {
+        for (std::string_view v : serial.column(city)) dc += v.size() > 6;
+    });
+    std::printf("%-34s %7.3f ms    %zu quoted cities\n", "scan one column", t * 1e3, dc);
+    std::printf("\n(checksum %zu)\n", check);
+}
@@ -0,0 +1,78 @@
+#include "../deduper.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <unordered_set>
+
+/*
+    Deduper benchmark
+    Use: Removing duplicates from random 64 bit ids (10% and 90% unique) and from strings:
+         std::unordered_set + copy, Deduper::dedupe (flat hash set, first-seen order),
+         dedupe with DedupeOrder::any (sort + sweep for numbers) and parallel_dedupe.
+    Build: g++ -std=c++20 -O2 -pthread bench/dedupeBench.cpp -o dedupeBench
+    Run:   ./dedupeBench [max size] [threads]   (default 10000000, hardware threads)
+*/
+
+template <typename F>
+static double msFor(F f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// What people write today: remember what was seen, copy the new ones out
+template <typename T>
+static std::size_t unorderedDedupe(std::vector<T>& v) {
+    std::unordered_set<T> seen;
+    std::vector<T> out;
+    for (T& x : v) {
+        if (seen.insert(x).second) out.push_back(std::move(x));
+    }
+    v = std::move(out);
+    return v.size();
+}
+
+template <typename T>
+static void row(const char* label, const std::vector<T>& data, std::size_t threadCount) {
+    Deduper d;
+    std::vector<T> a = data, b = data, c = data, e = data;
+    std::size_t expect = 0;
+    double stdMs = msFor([&] { expect = unorderedDedupe(a); });
+    double flatMs = msFor([&] { d.dedupe(b); });
+    double anyMs = msFor([&] { d.dedupe(c, DedupeOrder::any); });
+    double parMs = msFor([&] { d.parallel_dedupe(e, threadCount); });
+    if (b != a || e != a || c.size() != expect) {
+        std::fprintf(stderr, "Deduper disagrees with std::unordered_set\n");
+        std::exit(1);
+    }
+    std::printf("%-12s %10zu %10zu %11.1f ms %9.1f ms %9.1f ms %9.1f ms %7.2fx\n", label, data.size(), expect,
+                stdMs, flatMs, anyMs, parMs, stdMs / flatMs);
+}
+
+int main(int argc, char** argv) {
+    std::size_t maxSize = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    std::size_t threadCount = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : std::thread::hardware_concurrency();
+    std::mt19937_64 rng(19);
+
+    std::printf("%-12s %10s %10s %14s %12s %12s %12s %8s\n", "data", "n", "unique", "unordered_set", "dedupe",
+                "any order", "parallel", "speedup");
+    for (std::size_t n = 100000; n <= maxSize; n *= 10) {
+        for (std::size_t pct : { 10, 90 }) {
+            std::size_t distinct = n * pct / 100;
+            std::vector<std::uint64_t> ids(n);
+            for (auto& x : ids) x = rng() % distinct * 0x9e3779b97f4a7c15ull;   // spread out, like real ids
+            char label[32];
+            std::snprintf(label, sizeof(label), "u64 %zu%%", pct);
+            row(label, ids, threadCount);
+        }
+        if (n <= 1000000) {
+            std::vector<std::string> words(n);
+            for (auto& w : words) w = "user-" + std::to_string(rng() % (n / 2)) + "@example.com";
+            row("string 50%", words, threadCount);
+        }
+    }
+    std::printf("(%zu threads)\n", threadCount);
+    return 0;
+}
@@ -0,0 +1,127 @@
+#include "../fileLoader.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <string>
+
+/*
+    FileLoader benchmark
+    Use: Writes a text file of random length lines, then counts lines and bytes with
+         std::ifstream + std::getline, FileLoader::readAll + split, MappedFile (sequential
+         hint), ChunkReader / LineReader with and without the read-ahead thread. Also times
+         the open alone (mmap vs reading everything) and FileWriter against std::ofstream.
+    Build: g++ -std=c++20 -O2 -pthread bench/fileLoaderBench.cpp -o fileLoaderBench
+    Run:   ./fileLoaderBench [megabytes] [path]   (default 512, fileLoaderBench.txt)
+    Notes: The file is in the page cache after writing it, so this measures the CPU side.
+           For cold-disk numbers drop the cache first (echo 3 > /proc/sys/vm/drop_caches).
+*/
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+static double secondsFor(F f) {
+    auto start = Clock::now();
+    f();
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+struct Tally {
+    std::size_t lines = 0;
+    std::size_t bytes = 0;
+    void operator()(std::string_view l) {
+        ++lines;
+        bytes += l.size();
+    }
+};
+
+static void report(const char* name, double seconds, std::size_t fileBytes, const Tally& t) {
+    std::printf("%-32s %8.1f ms %7.2f GB/s  (%zu lines, %zu bytes)\n", name, seconds * 1e3,
+                static_cast<double>(fileBytes) / seconds / 1e9, t.lines, t.bytes);
+}
+
+int main(int argc, char** argv) {
+    std::size_t mb = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 512;
+    std::string path = argc > 2 ? argv[2] : "fileLoaderBench.txt";
+
+    std::mt19937 rng(5);
+    std::string line;
+    std::size_t fileBytes = 0;
+    double t = secondsFor([&] {
+        FileWriter w(path);
+        while (fileBytes < (mb << 20)) {
+            line.assign(rng() % 120, static_cast<char>('a' + rng() % 26));
+            w.writeLine(line);
+            fileBytes += line.size() + 1;
+        }
+        w.commit();
+    });
+    std::printf("%.1f MB file\n\n", static_cast<double>(fileBytes) / 1e6);
+    std::printf("%-32s %8.1f ms\n", "write FileWriter", t * 1e3);
+    t = secondsFor([&] {
+        std::ofstream out(path + ".std");
+        std::mt19937 again(5);
+        for (std::size_t n = 0; n < fileBytes;) {
+            line.assign(again() % 120, static_cast<char>('a' + again() % 26));
+            out << line << '\n';
+            n += line.size() + 1;
+        }
+    });
+    std::printf("%-32s %8.1f ms\n\n", "write std::ofstream", t * 1e3);
+    std::remove((path + ".std").c_str());
+
+    {
+        Tally tally;
+        t = secondsFor([&] {
+            std::ifstream in(path);
+            std::string l;
+            while (std::getline(in, l)) tally(l);
+        });
+        report("std::ifstream + getline", t, fileBytes, tally);
+    }
+    {
+        Tally tally;
+        t = secondsFor([&] {
+            std::string all;
+            FileLoader::readAll(path, all);
+            StringSplitter::forEachLine(all, tally);
+        });
+        report("readAll + forEachLine", t, fileBytes, tally);
+    }
+    {
+        Tally tally;
+        t = secondsFor([&] { FileLoader::forEachLine(path, tally); });
+        report("MappedFile + forEachLine", t, fileBytes, tally);
+    }
+    for (bool background : { false, true }) {
+        Tally tally;
+        t = secondsFor([&] {
+            LineReader r(path, std::size_t(1) << 20, background);
+            r.forEach(tally);
+        });
+        report(background ? "LineReader, read-ahead" : "LineReader, no read-ahead", t, fileBytes, tally);
+    }
+    {
+        Tally tally;
+        t = secondsFor([&] {
+            ChunkReader r(path);
+            std::string_view chunk;
+            while (r.next(chunk)) tally.lines += ByteScan::count(chunk.data(), chunk.size(), '\n');
+        });
+        report("ChunkReader + count newlines", t, fileBytes, tally);
+    }
+
+    std::printf("\n");
+    t = secondsFor([&] {
+        MappedFile m(path);
+        if (m.size() != fileBytes) std::exit(1);
+    });
+    std::printf("%-32s %8.3f ms\n", "open only: MappedFile", t * 1e3);
+    t = secondsFor([&] {
+        std::string all;
+        FileLoader::readAll(path, all);
+    });
+    std::printf("%-32s %8.3f ms\n", "open only: readAll", t * 1e3);
+    std::remove(path.c_str());
+}
@@ -0,0 +1,84 @@
+#include "../frequencyCounter.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+/*
+    FrequencyCounter benchmark
+    Use: Counts a skewed stream of 64 bit ids (a few heavy hitters, a long tail of mostly
+         distinct ids) with std::unordered_map, exact mode and bounded mode (Space-Saving +
+         Count-Min), serial and addParallel. Prints time, memory, and how many of the real
+         top 100 the bounded top 100 found.
+    Build: g++ -std=c++20 -O2 -pthread bench/frequencyBench.cpp -o frequencyBench
+    Run:   ./frequencyBench [items] [threads]   (default 20000000, hardware threads)
+*/
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+static double msFor(F f) {
+    auto start = Clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000000;
+    std::size_t threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 0;
+
+    // 1 in 4 items from 1000 heavy ids (Zipf-ish), the rest from a huge id space
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    std::vector<std::uint64_t> ids(n);
+    for (auto& id : ids) id = rng() % 4 == 0 ? static_cast<std::uint64_t>(1000.0 * u(rng) * u(rng) * u(rng)) : (rng() | (std::uint64_t(1) << 40));
+    std::printf("%zu items\n\n", n);
+
+    std::unordered_map<std::uint64_t, std::uint64_t> std_counts;
+    double stdMs = msFor([&] {
+        for (std::uint64_t id : ids) ++std_counts[id];
+    });
+    // rough: one node (key, value, next, cached hash) + one bucket pointer per key
+    std::size_t stdBytes = std_counts.size() * (4 * sizeof(std::uint64_t) + sizeof(void*)) + std_counts.bucket_count() * sizeof(void*);
+    std::printf("%-26s %9.1f ms  %9.1f MB  %zu distinct\n", "std::unordered_map", stdMs, static_cast<double>(stdBytes) / 1e6, std_counts.size());
+
+    FrequencyCounter<std::uint64_t> exact;
+    double exactMs = msFor([&] { exact.addAll(ids); });
+    std::printf("%-26s %9.1f ms  %9.1f MB\n", "exact", exactMs, static_cast<double>(exact.bytes()) / 1e6);
+
+    FrequencyCounter<std::uint64_t> exactPar;
+    double exactParMs = msFor([&] { exactPar.addParallel(ids, threads); });
+    std::printf("%-26s %9.1f ms  %9.1f MB\n", "exact addParallel", exactParMs, static_cast<double>(exactPar.bytes()) / 1e6);
+
+    std::vector<FrequencyItem<std::uint64_t>> truth;
+    double topMs = msFor([&] { truth = exact.topK(100); });
+    std::printf("%-26s %9.1f ms\n\n", "exact topK(100)", topMs);
+
+    auto found = [&](const std::vector<FrequencyItem<std::uint64_t>>& got) {
+        std::size_t hits = 0;
+        for (const auto& t : truth)
+            for (const auto& g : got) hits += g.key == t.key;
+        return hits;
+    };
+    auto maxError = [&](const FrequencyCounter<std::uint64_t>& c) {
+        std::uint64_t worst = 0;
+        for (const auto& t : truth) worst = std::max(worst, c.count(t.key) - t.count);
+        return worst;
+    };
+
+    for (std::size_t track : { 1024u, 8192u }) {
+        FrequencyCounter<std::uint64_t> bounded(CountMode::bounded, track, std::size_t(1) << 16, 4);
+        double ms = msFor([&] { bounded.addAll(ids); });
+        auto top = bounded.topK(100);
+        std::printf("bounded track %-5zu        %9.1f ms  %9.1f MB  top100 found %zu/100, worst overcount %llu\n", track, ms,
+                    static_cast<double>(bounded.bytes()) / 1e6, found(top), static_cast<unsigned long long>(maxError(bounded)));
+
+        FrequencyCounter<std::uint64_t> par(CountMode::bounded, track, std::size_t(1) << 16, 4);
+        ms = msFor([&] { par.addParallel(ids, threads); });
+        top = par.topK(100);
+        std::printf("  addParallel              %9.1f ms  %9.1f MB  top100 found %zu/100, worst overcount %llu\n", ms,
+                    static_cast<double>(par.bytes()) / 1e6, found(top), static_cast<unsigned long long>(maxError(par)));
+    }
+}
@@ -0,0 +1,126 @@
+#include "../fuzzyMatchLite.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+/*
+    FuzzyMatchLite benchmark
+    Use: "Did you mean" lookups of misspelled names (1-2 random edits, random case) in a
+         dictionary of generated command / entity names. Compares the plain DP distance
+         against every name, the Myers scan (FuzzyMatchLite::find) and FuzzyIndex, and checks
+         that all three agree on the best distance.
+    Build: g++ -std=c++20 -O2 bench/fuzzyBench.cpp -o fuzzyBench
+    Run:   ./fuzzyBench [names] [queries]   (default 300000, 2000)
+    Notes: The plain DP only runs the first 50 queries, it takes a while.
+*/
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+static double secondsFor(F f) {
+    auto start = Clock::now();
+    f();
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Full (m + 1) x (n + 1) DP, folded like the rest: the "simple distance score"
+static std::size_t plainDistance(std::string_view a, std::string_view b, std::vector<std::size_t>& row) {
+    row.resize(b.size() + 1);
+    for (std::size_t j = 0; j <= b.size(); ++j) row[j] = j;
+    for (std::size_t i = 1; i <= a.size(); ++i) {
+        std::size_t diag = row[0];
+        row[0] = i;
+        for (std::size_t j = 1; j <= b.size(); ++j) {
+            std::size_t up = row[j];
+            bool same = CaseFold::equal(a.substr(i - 1, 1), b.substr(j - 1, 1));
+            row[j] = std::min({ up + 1, row[j - 1] + 1, diag + !same });
+            diag = up;
+        }
+    }
+    return row[b.size()];
+}
+
+int main(int argc, char** argv) {
+    std::size_t names = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 300000;
+    std::size_t queries = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 2000;
+
+    static const char* parts[] = { "get", "set", "user", "order", "cache", "item", "list", "sync", "load", "save", "file",
+                                   "config", "index", "query", "node", "tree", "stat", "log", "net", "auth", "page", "view" };
+    std::mt19937 rng(11);
+    std::vector<std::string> dict;
+    dict.reserve(names);
+    for (std::size_t i = 0; i < names; ++i) {
+        std::string s;
+        for (std::size_t p = 0, parts2 = 2 + rng() % 2; p < parts2; ++p) {
+            if (p) s += rng() % 2 ? "_" : "-";
+            s += parts[rng() % std::size(parts)];
+        }
+        s += std::to_string(rng() % 1000);
+        dict.push_back(std::move(s));
+    }
+    std::vector<std::string> typos;
+    for (std::size_t q = 0; q < queries; ++q) {
+        std::string s = dict[rng() % dict.size()];
+        for (std::size_t e = 1 + rng() % 2; e-- > 0;) {
+            std::size_t pos = rng() % s.size();
+            switch (rng() % 3) {
+                case 0: s.erase(pos, 1); break;
+                case 1: s.insert(pos, 1, static_cast<char>('a' + rng() % 26)); break;
+                default: s[pos] = static_cast<char>('a' + rng() % 26); break;
+            }
+        }
+        if (rng() % 4 == 0) s[0] = static_cast<char>(s[0] >= 'a' && s[0] <= 'z' ? s[0] - 32 : s[0]);
+        typos.push_back(std::move(s));
+    }
+
+    FuzzyIndex index;
+    double build = secondsFor([&] { index = FuzzyIndex(dict); });
+    std::printf("%zu names, index built in %.1f ms, %.1f MB\n\n", dict.size(), build * 1e3, static_cast<double>(index.bytes()) / 1e6);
+
+    std::size_t plainRuns = std::min<std::size_t>(50, typos.size());
+    std::vector<std::size_t> plainBest(plainRuns);
+    std::vector<std::size_t> row;
+    double t = secondsFor([&] {
+        for (std::size_t q = 0; q < plainRuns; ++q) {
+            std::size_t best = SIZE_MAX;
+            for (const std::string& w : dict) best = std::min(best, plainDistance(typos[q], w, row));
+            plainBest[q] = best;
+        }
+    });
+    std::printf("%-28s %10.1f us/query\n", "plain DP, every name", t / static_cast<double>(plainRuns) * 1e6);
+
+    FuzzyOptions opt{ 2, 5 };
+    std::vector<std::size_t> scanBest(typos.size(), SIZE_MAX), indexBest(typos.size(), SIZE_MAX);
+    std::size_t scanRuns = std::min<std::size_t>(200, typos.size());
+    t = secondsFor([&] {
+        for (std::size_t q = 0; q < scanRuns; ++q) {
+            std::vector<FuzzyMatch> m = FuzzyMatchLite::find(dict, typos[q], opt);
+            if (!m.empty()) scanBest[q] = m[0].distance;
+        }
+    });
+    std::printf("%-28s %10.1f us/query\n", "Myers scan, every name", t / static_cast<double>(scanRuns) * 1e6);
+
+    std::size_t found = 0;
+    t = secondsFor([&] {
+        for (std::size_t q = 0; q < typos.size(); ++q) {
+            std::vector<FuzzyMatch> m = index.find(typos[q], opt);
+            if (!m.empty()) {
+                indexBest[q] = m[0].distance;
+                ++found;
+            }
+        }
+    });
+    std::printf("%-28s %10.1f us/query  (%zu of %zu within 2 edits)\n", "FuzzyIndex", t / static_cast<double>(typos.size()) * 1e6,
+                found, typos.size());
+
+    for (std::size_t q = 0; q < scanRuns; ++q) {
+        bool plainOk = q >= plainRuns || (plainBest[q] <= 2 ? plainBest[q] == indexBest[q] : indexBest[q] == SIZE_MAX);
+        if (!plainOk || scanBest[q] != indexBest[q]) {
+            std::fprintf(stderr, "query %zu (%s) disagrees\n", q, typos[q].c_str());
+            return 1;
+        }
+    }
+}
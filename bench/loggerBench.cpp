@@ -0,0 +1,89 @@
+#include "../logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+    Logger benchmark
+    Use: Call site latency (p50 / p99 / p99.9, each call timed on its own) of Logger against a
+         mutex + fprintf logger writing the same lines, with 1, 2, 4 and 8 threads logging
+         "request {} took {} us from {}" in a loop. Both write to a file.
+    Build: g++ -std=c++20 -O2 -pthread bench/loggerBench.cpp -o loggerBench
+    Run:   ./loggerBench [calls per thread] [path]   (default 200000, loggerBench.log)
+    Notes: The two clock reads around each call add ~20-40 ns to every number. Logger runs
+           with LogOverflow::block so both write every line; dropped records would flatter it.
+*/
+
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+    double callsPerSec;
+    double p50, p99, p999;   // ns
+};
+
+template <typename Call>
+static Result run(unsigned threads, std::size_t calls, Call call) {
+    std::vector<std::vector<std::uint32_t>> lat(threads);
+    std::vector<std::thread> pool;
+    auto start = Clock::now();
+    for (unsigned t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            std::vector<std::uint32_t>& mine = lat[t];
+            mine.reserve(calls);
+            for (std::size_t i = 0; i < calls; ++i) {
+                auto a = Clock::now();
+                call(t, i);
+                auto b = Clock::now();
+                mine.push_back(static_cast<std::uint32_t>(std::min<std::int64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(b - a).count(), UINT32_MAX)));
+            }
+        });
+    }
+    for (std::thread& th : pool) th.join();
+    double secs = std::chrono::duration<double>(Clock::now() - start).count();
+    std::vector<std::uint32_t> all;
+    for (auto& v : lat) all.insert(all.end(), v.begin(), v.end());
+    auto pct = [&](double p) {
+        std::size_t k = static_cast<std::size_t>(p * static_cast<double>(all.size() - 1));
+        std::nth_element(all.begin(), all.begin() + static_cast<std::ptrdiff_t>(k), all.end());
+        return static_cast<double>(all[k]);
+    };
+    return { static_cast<double>(all.size()) / secs, pct(0.5), pct(0.99), pct(0.999) };
+}
+
+static void print(const char* name, unsigned threads, const Result& r) {
+    std::printf("%-18s %u threads  %7.2f M calls/s   p50 %8.0f ns  p99 %8.0f ns  p99.9 %9.0f ns\n", name, threads, r.callsPerSec / 1e6,
+                r.p50, r.p99, r.p999);
+}
+
+int main(int argc, char** argv) {
+    std::size_t calls = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+    std::string path = argc > 2 ? argv[2] : "loggerBench.log";
+    static const char* hosts[] = { "10.0.0.1", "10.0.0.2", "192.168.1.20", "172.16.4.9" };
+
+    for (unsigned threads : { 1u, 2u, 4u, 8u }) {
+        {
+            std::FILE* f = std::fopen(path.c_str(), "wb");
+            std::mutex m;
+            Result r = run(threads, calls, [&](unsigned t, std::size_t i) {
+                std::lock_guard<std::mutex> guard(m);
+                std::fprintf(f, "INFO [%u] request %zu took %zu us from %s\n", t, i, i % 977, hosts[i & 3]);
+            });
+            std::fclose(f);
+            print("mutex + fprintf", threads, r);
+        }
+        {
+            std::remove(path.c_str());
+            Logger log(4096, LogOverflow::block);
+            log.addSink(Logger::file(path));
+            Result r = run(threads, calls, [&](unsigned, std::size_t i) { log.info("request {} took {} us from {}", i, i % 977, hosts[i & 3]); });
+            log.flush();
+            print("Logger", threads, r);
+        }
+    }
+    std::remove(path.c_str());
+}
@@ -0,0 +1,131 @@
+#include "../lruCache.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/*
+    LRUCache benchmark
+    Use: get-or-put over a skewed (Zipf-like) key stream: std::unordered_map + std::list
+         against LRUCache (lru and clock), then 1/2/4/8 threads on one mutex-guarded
+         std version against ShardedLRUCache. Prints Mops/s and the hit rate.
+    Build: g++ -std=c++20 -O2 -pthread bench/lruBench.cpp -o lruBench
+    Run:   ./lruBench [operations] [capacity]   (default 4000000, 100000)
+*/
+
+using Clock = std::chrono::steady_clock;
+
+// The usual map + list version
+struct StdLru {
+    std::size_t cap;
+    std::list<std::pair<std::uint64_t, std::uint64_t>> order;
+    std::unordered_map<std::uint64_t, std::list<std::pair<std::uint64_t, std::uint64_t>>::iterator> map;
+    std::uint64_t hits = 0, misses = 0;
+
+    explicit StdLru(std::size_t c) : cap(c) {}
+    std::uint64_t getOrPut(std::uint64_t k) {
+        auto it = map.find(k);
+        if (it != map.end()) {
+            ++hits;
+            order.splice(order.begin(), order, it->second);
+            return it->second->second;
+        }
+        ++misses;
+        if (map.size() == cap) {
+            map.erase(order.back().first);
+            order.pop_back();
+        }
+        order.emplace_front(k, k * 3);
+        map[k] = order.begin();
+        return k * 3;
+    }
+};
+
+// Keys skewed towards small numbers: a few hot keys and a long tail
+static std::vector<std::uint64_t> keyStream(std::size_t n, std::size_t keySpace, unsigned seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<std::uint64_t> keys(n);
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    for (auto& k : keys) {
+        double x = u(rng);
+        k = static_cast<std::uint64_t>(static_cast<double>(keySpace) * x * x * x);
+    }
+    return keys;
+}
+
+template <typename F>
+static double mopsFor(std::size_t ops, F f) {
+    auto start = Clock::now();
+    f();
+    return static_cast<double>(ops) / std::chrono::duration<double>(Clock::now() - start).count() / 1e6;
+}
+
+int main(int argc, char** argv) {
+    std::size_t ops = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+    std::size_t capacity = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 100000;
+    std::vector<std::uint64_t> keys = keyStream(ops, capacity * 10, 1);
+    std::printf("%zu operations, capacity %zu, %u hardware threads\n\n", ops, capacity, std::thread::hardware_concurrency());
+
+    std::uint64_t sink = 0;
+    {
+        StdLru c(capacity);
+        double m = mopsFor(ops, [&] { for (std::uint64_t k : keys) sink += c.getOrPut(k); });
+        std::printf("%-28s %8.2f Mops/s  hit rate %.3f\n", "unordered_map + list", m,
+                    static_cast<double>(c.hits) / static_cast<double>(c.hits + c.misses));
+    }
+    for (Eviction e : { Eviction::lru, Eviction::clock }) {
+        LRUCache<std::uint64_t, std::uint64_t> c(capacity, e);
+        double m = mopsFor(ops, [&] { for (std::uint64_t k : keys) sink += c.getOrPut(k, [&] { return k * 3; }); });
+        std::printf("%-28s %8.2f Mops/s  hit rate %.3f\n", e == Eviction::lru ? "LRUCache lru" : "LRUCache clock", m, c.stats().hitRate());
+    }
+
+    std::printf("\n");
+    for (unsigned threads : { 1u, 2u, 4u, 8u }) {
+        std::size_t per = ops / threads;
+        auto runThreads = [&](auto body) {
+            std::vector<std::thread> pool;
+            for (unsigned t = 0; t < threads; ++t) pool.emplace_back([&, t] { body(t); });
+            for (std::thread& th : pool) th.join();
+        };
+        std::vector<std::vector<std::uint64_t>> streams;
+        for (unsigned t = 0; t < threads; ++t) streams.push_back(keyStream(per, capacity * 10, t + 7));
+
+        {
+            StdLru c(capacity);
+            std::mutex m;
+            double mops = mopsFor(per * threads, [&] {
+                runThreads([&](unsigned t) {
+                    std::uint64_t local = 0;
+                    for (std::uint64_t k : streams[t]) {
+                        std::lock_guard<std::mutex> lock(m);
+                        local += c.getOrPut(k);
+                    }
+                    std::lock_guard<std::mutex> lock(m);
+                    sink += local;
+                });
+            });
+            std::printf("%-28s %2u threads %8.2f Mops/s  hit rate %.3f\n", "mutex + unordered_map", threads, mops,
+                        static_cast<double>(c.hits) / static_cast<double>(c.hits + c.misses));
+        }
+        for (Eviction e : { Eviction::lru, Eviction::clock }) {
+            ShardedLRUCache<std::uint64_t, std::uint64_t> c(capacity, 0, e);
+            std::atomic<std::uint64_t> total{0};
+            double mops = mopsFor(per * threads, [&] {
+                runThreads([&](unsigned t) {
+                    std::uint64_t local = 0;
+                    for (std::uint64_t k : streams[t]) local += c.getOrPut(k, [&] { return k * 3; });
+                    total += local;
+                });
+            });
+            sink += total.load();
+            std::printf("%-28s %2u threads %8.2f Mops/s  hit rate %.3f\n", e == Eviction::lru ? "ShardedLRUCache lru" : "ShardedLRUCache clock",
+                        threads, mops, c.stats().hitRate());
+        }
+    }
+    std::printf("\n(checksum %llu)\n", static_cast<unsigned long long>(sink));
+}
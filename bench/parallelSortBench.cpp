@@ -0,0 +1,74 @@
+#include "../sorter.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+/*
+    Parallel Sorter scaling benchmark
+    Use: Time parallel_introsort and parallel_stablesort on 1, 2, 4 ... N threads
+         and print the speedup over the single thread run. The single thread run passes a
+         lambda too, so it times the same comparison engine (the default std::less would
+         pick the radix / multikey sorts, see sortBench).
+    Build: g++ -std=c++20 -O2 -pthread bench/parallelSortBench.cpp -o parallelSortBench
+    Run:   ./parallelSortBench [n] [max threads]   (default 10000000, all hardware threads)
+*/
+
+template <typename T, typename F>
+static double seconds(const std::vector<T>& input, F f) {
+    std::vector<T> v = input;
+    auto start = std::chrono::steady_clock::now();
+    f(v);
+    auto stop = std::chrono::steady_clock::now();
+    if (!std::is_sorted(v.begin(), v.end())) {
+        std::fprintf(stderr, "output not sorted!\n");
+        std::exit(1);
+    }
+    return std::chrono::duration<double>(stop - start).count();
+}
+
+template <typename T>
+static void run(const char* name, const std::vector<T>& input, std::size_t maxThreads) {
+    Sorter sorter;
+    auto less = [](const T& a, const T& b) { return a < b; };
+    double baseIntro = 0, baseStable = 0;
+
+    std::printf("\n%s, n = %zu\n", name, input.size());
+    std::printf("%8s %14s %9s %14s %9s\n", "threads", "introsort", "speedup", "stablesort", "speedup");
+    std::vector<std::size_t> counts;
+    for (std::size_t t = 1; t < maxThreads; t *= 2) counts.push_back(t);
+    counts.push_back(maxThreads);
+
+    for (std::size_t t : counts) {
+        ThreadPool pool(t > 1 ? t - 1 : 1);   // the calling thread is the t-th one
+        double intro = seconds(input, [&](std::vector<T>& v) {
+            if (t == 1) sorter.introsort(v, less);
+            else sorter.parallel_introsort(v, pool, less);
+        });
+        double stable = seconds(input, [&](std::vector<T>& v) {
+            if (t == 1) sorter.stablesort(v, less);
+            else sorter.parallel_stablesort(v, pool, less);
+        });
+        if (t == 1) {
+            baseIntro = intro;
+            baseStable = stable;
+        }
+        std::printf("%8zu %11.3f s %8.2fx %11.3f s %8.2fx\n", t, intro, baseIntro / intro, stable, baseStable / stable);
+    }
+}
+
+int main(int argc, char** argv) {
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    std::size_t maxThreads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : std::thread::hardware_concurrency();
+    if (maxThreads == 0) maxThreads = 1;
+
+    std::mt19937_64 rng(42);
+    std::vector<int> ints(n);
+    for (int& x : ints) x = static_cast<int>(rng());
+    run("int, random", ints, maxThreads);
+
+    std::vector<std::string> strs(n / 10);
+    for (std::string& x : strs) x = "key_" + std::to_string(rng() % 100000000);
+    run("std::string, random", strs, maxThreads);
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include "../profilerLite.h"
+#include "../sorter.h"
+#include "../search.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+    ProfilerLite benchmark
+    Use: Cost of one PROFILE_SCOPE (on, switched off at run time, with tracing) next to a
+         bare steady_clock pair, scopes per second with 1, 2, 4 and 8 threads, then a
+         Sorter / Search run whose report and Chrome trace (profilerBench.json) show the
+         built-in probes when they are compiled in.
+    Build: g++ -std=c++20 -O2 -pthread bench/profilerBench.cpp -o profilerBench
+           g++ -std=c++20 -O2 -pthread -DPROFILER_PROBES=1 bench/profilerBench.cpp -o profilerBenchProbes
+    Run:   ./profilerBench [scopes per thread] [elements]   (default 2000000, 1000000)
+    Notes: Build both and compare the sort times to see what the probes cost.
+*/
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+static double nsPer(std::size_t n, F f) {
+    auto start = Clock::now();
+    f();
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / static_cast<double>(n);
+}
+
+static thread_local volatile std::size_t sink;
+
+int main(int argc, char** argv) {
+    std::size_t scopes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+    std::size_t elements = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+    std::printf("probes %s, clock %s\n\n", ProfilerLite::probes ? "on" : "off", PROFILER_TSC ? "TSC" : "steady_clock");
+
+    double empty = nsPer(scopes, [&] {
+        for (std::size_t i = 0; i < scopes; ++i) sink = i;
+    });
+    double clockPair = nsPer(scopes, [&] {
+        for (std::size_t i = 0; i < scopes; ++i) {
+            auto a = Clock::now();
+            sink = i;
+            sink = static_cast<std::size_t>((Clock::now() - a).count());
+        }
+    });
+    double scope = nsPer(scopes, [&] {
+        for (std::size_t i = 0; i < scopes; ++i) {
+            PROFILE_SCOPE("bench scope");
+            sink = i;
+        }
+    });
+    ProfilerLite::setEnabled(false);
+    double off = nsPer(scopes, [&] {
+        for (std::size_t i = 0; i < scopes; ++i) {
+            PROFILE_SCOPE("bench scope");
+            sink = i;
+        }
+    });
+    ProfilerLite::setEnabled(true);
+    ProfilerLite::startTrace(std::size_t(1) << 16);
+    double traced = nsPer(scopes, [&] {
+        for (std::size_t i = 0; i < scopes; ++i) {
+            PROFILE_SCOPE("bench traced");
+            sink = i;
+        }
+    });
+    ProfilerLite::stopTrace();
+    std::printf("%-34s %7.1f ns\n", "empty loop", empty);
+    std::printf("%-34s %7.1f ns\n", "steady_clock pair", clockPair);
+    std::printf("%-34s %7.1f ns\n", "PROFILE_SCOPE", scope);
+    std::printf("%-34s %7.1f ns\n", "PROFILE_SCOPE, setEnabled(false)", off);
+    std::printf("%-34s %7.1f ns  (first 64K kept)\n\n", "PROFILE_SCOPE, tracing", traced);
+
+    for (unsigned threads : { 1u, 2u, 4u, 8u }) {
+        auto start = Clock::now();
+        std::vector<std::thread> pool;
+        for (unsigned t = 0; t < threads; ++t) {
+            pool.emplace_back([&] {
+                for (std::size_t i = 0; i < scopes; ++i) {
+                    PROFILE_SCOPE("bench threads");
+                    sink = i;
+                }
+            });
+        }
+        for (std::thread& th : pool) th.join();
+        double secs = std::chrono::duration<double>(Clock::now() - start).count();
+        std::printf("%u threads  %7.2f M scopes/s\n", threads, static_cast<double>(scopes * threads) / secs / 1e6);
+    }
+
+    ProfilerLite::reset();
+    ProfilerLite::startTrace();
+    std::mt19937_64 rng(3);
+    std::vector<std::uint64_t> data(elements);
+    for (std::uint64_t& x : data) x = rng();
+    std::vector<std::uint64_t> copy = data;
+    Sorter sorter;
+    Search search;
+    auto less = [](std::uint64_t a, std::uint64_t b) { return a < b; };   // a lambda keeps the comparison sorts
+    double sortMs = nsPer(1, [&] { sorter.introsort(data, less); }) / 1e6;
+    double stableMs = nsPer(1, [&] { sorter.stablesort(copy, less); }) / 1e6;
+    std::size_t hits = 0;
+    double findNs = nsPer(100000, [&] {
+        for (std::size_t i = 0; i < 100000; ++i) hits += search.binaryFind(data, copy[(i * 7919) % copy.size()], less).found;
+    });
+    ProfilerLite::stopTrace();
+    std::printf("\nintrosort %.1f ms, stablesort %.1f ms, binaryFind %.0f ns (%zu hits)\n\n", sortMs, stableMs, findNs, hits);
+    std::printf("%s", ProfilerLite::report().c_str());
+    if (ProfilerLite::writeChromeTrace("profilerBench.json")) std::printf("\ntrace written to profilerBench.json\n");
+}
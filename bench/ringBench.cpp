@@ -0,0 +1,165 @@
+#include "../ringBuffer.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+    RingBuffer benchmark
+    Use: Items per second and push-to-pop latency (p50 / p99 / p99.9) for RingBuffer (one
+         thread), SpscRing and MpmcRing at 1/1, 2/2 and 4/4 producers/consumers, single
+         and batched calls, against a std::mutex + std::deque queue.
+    Build: g++ -std=c++20 -O2 -pthread bench/ringBench.cpp -o ringBench
+    Run:   ./ringBench [items] [capacity]   (default 2000000, 1024)
+    Notes: A full push or an empty pop yields, so the numbers stay meaningful when there
+           are fewer cores than threads (latency then mostly measures the scheduler).
+*/
+
+using Clock = std::chrono::steady_clock;
+
+static std::uint64_t nowNs() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count());
+}
+
+// Mutex + deque, bounded like the rings
+struct LockedQueue {
+    std::mutex m;
+    std::deque<std::uint64_t> q;
+    std::size_t cap;
+    explicit LockedQueue(std::size_t c) : cap(c) {}
+    bool push(std::uint64_t v) {
+        std::lock_guard<std::mutex> lock(m);
+        if (q.size() == cap) return false;
+        q.push_back(v);
+        return true;
+    }
+    bool pop(std::uint64_t& out) {
+        std::lock_guard<std::mutex> lock(m);
+        if (q.empty()) return false;
+        out = q.front();
+        q.pop_front();
+        return true;
+    }
+    std::size_t pushBatch(std::span<const std::uint64_t> v) {
+        std::lock_guard<std::mutex> lock(m);
+        std::size_t n = std::min(v.size(), cap - q.size());
+        q.insert(q.end(), v.begin(), v.begin() + static_cast<std::ptrdiff_t>(n));
+        return n;
+    }
+    std::size_t popBatch(std::span<std::uint64_t> out) {
+        std::lock_guard<std::mutex> lock(m);
+        std::size_t n = std::min(out.size(), q.size());
+        std::copy_n(q.begin(), n, out.begin());
+        q.erase(q.begin(), q.begin() + static_cast<std::ptrdiff_t>(n));
+        return n;
+    }
+};
+
+static constexpr std::size_t batchSize = 32;
+
+// Every item is the ns timestamp of its push; consumers turn them into latencies.
+template <typename Queue>
+static void run(const char* name, Queue& q, int producers, int consumers, std::size_t items, bool batched) {
+    std::size_t perProducer = items / static_cast<std::size_t>(producers);
+    std::size_t total = perProducer * static_cast<std::size_t>(producers);
+    std::atomic<std::size_t> popped{0};
+    std::vector<std::vector<std::uint64_t>> lat(static_cast<std::size_t>(consumers));
+    std::vector<std::thread> threads;
+
+    auto start = Clock::now();
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&] {
+            std::uint64_t buf[batchSize];
+            for (std::size_t done = 0; done < perProducer;) {
+                if (batched) {
+                    std::size_t k = std::min(batchSize, perProducer - done);
+                    std::uint64_t t = nowNs();
+                    for (std::size_t i = 0; i < k; ++i) buf[i] = t;
+                    std::size_t n = q.pushBatch(std::span<const std::uint64_t>(buf, k));
+                    if (n == 0) std::this_thread::yield();
+                    done += n;
+                }
+                else if (q.push(nowNs())) ++done;
+                else std::this_thread::yield();
+            }
+        });
+    }
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&, c] {
+            std::vector<std::uint64_t>& mine = lat[static_cast<std::size_t>(c)];
+            mine.reserve(total / static_cast<std::size_t>(consumers) + batchSize);
+            std::uint64_t buf[batchSize];
+            while (popped.load(std::memory_order_relaxed) < total) {
+                std::size_t n = batched ? q.popBatch(std::span<std::uint64_t>(buf, batchSize)) : (q.pop(buf[0]) ? 1 : 0);
+                if (n == 0) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                std::uint64_t t = nowNs();
+                for (std::size_t i = 0; i < n; ++i) mine.push_back(t - buf[i]);
+                popped.fetch_add(n, std::memory_order_relaxed);
+            }
+        });
+    }
+    for (std::thread& t : threads) t.join();
+    double secs = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::vector<std::uint64_t> all;
+    for (auto& v : lat) all.insert(all.end(), v.begin(), v.end());
+    auto pct = [&](double p) {
+        std::size_t k = static_cast<std::size_t>(p * static_cast<double>(all.size() - 1));
+        std::nth_element(all.begin(), all.begin() + static_cast<std::ptrdiff_t>(k), all.end());
+        return static_cast<double>(all[k]) / 1000.0;
+    };
+    if (all.size() != total) {
+        std::fprintf(stderr, "%s lost items (%zu of %zu)\n", name, all.size(), total);
+        std::exit(1);
+    }
+    std::printf("%-22s %dP/%dC %-6s %8.2f Mops/s   p50 %9.2f us  p99 %9.2f us  p99.9 %9.2f us\n", name, producers, consumers,
+                batched ? "batch" : "single", static_cast<double>(total) / secs / 1e6, pct(0.5), pct(0.99), pct(0.999));
+}
+
+int main(int argc, char** argv) {
+    std::size_t items = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+    std::size_t capacity = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1024;
+    std::printf("%zu items, capacity %zu, %u hardware threads\n\n", items, capacity, std::thread::hardware_concurrency());
+
+    // One thread: push a batch then pop it back, no synchronisation at all
+    {
+        RingBuffer<std::uint64_t> r(capacity);
+        std::vector<std::uint64_t> buf(r.capacity());
+        std::uint64_t sum = 0;
+        auto start = Clock::now();
+        for (std::size_t done = 0; done < items;) {
+            for (std::size_t i = 0; i < buf.size() && done < items; ++i, ++done) r.push(done);
+            std::uint64_t v;
+            while (r.pop(v)) sum += v;
+        }
+        double secs = std::chrono::duration<double>(Clock::now() - start).count();
+        std::printf("%-22s 1 thread  single %8.2f Mops/s   (checksum %llu)\n", "RingBuffer", static_cast<double>(items) / secs / 1e6,
+                    static_cast<unsigned long long>(sum));
+    }
+
+    for (bool batched : { false, true }) {
+        std::printf("\n");
+        {
+            SpscRing<std::uint64_t> q(capacity);
+            run("SpscRing", q, 1, 1, items, batched);
+        }
+        for (int n : { 1, 2, 4 }) {
+            {
+                MpmcRing<std::uint64_t> q(capacity);
+                run("MpmcRing", q, n, n, items, batched);
+            }
+            {
+                LockedQueue q(capacity);
+                run("mutex + std::deque", q, n, n, items, batched);
+            }
+        }
+    }
+}
@@ -0,0 +1,66 @@
+#include "../search.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+/*
+    Linear scan benchmark
+    Use: Search::find / findIf / countIf with a plain lambda (generic loop) vs the built-in
+         predicates (SimdScan kernels) on int, float and double arrays that fit in L2 and in RAM.
+         Every find has to walk the whole array (the target is the last element).
+    Build: g++ -std=c++20 -O2 bench/scanBench.cpp -o scanBench
+    Run:   ./scanBench [reps]   (default 20)
+*/
+
+template <typename F>
+static double nsPerElement(std::size_t n, int reps, F f) {
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < reps; ++r) f();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / (static_cast<double>(n) * reps);
+}
+
+static volatile std::size_t sink;
+
+template <typename T>
+static void run(const char* type, std::size_t n, int reps) {
+    std::mt19937 rng(9);
+    std::vector<T> data(n);
+    for (T& x : data) x = static_cast<T>(rng() % 1000);
+    data.back() = static_cast<T>(5000);
+    const T target = static_cast<T>(5000), lo = static_cast<T>(100), hi = static_cast<T>(199);
+
+    Search search;
+    auto lambdaEq = [&](const T& x) { return x == target; };
+    auto lambdaIn = [&](const T& x) { return lo <= x && x <= hi; };
+
+    double findLambda = nsPerElement(n, reps, [&] { sink = search.findIf(data, lambdaEq).index; });
+    double findSimd   = nsPerElement(n, reps, [&] { sink = search.find(data, target).index; });
+    double stdFind    = nsPerElement(n, reps, [&] { sink = static_cast<std::size_t>(std::find(data.begin(), data.end(), target) - data.begin()); });
+    double countLambda = nsPerElement(n, reps, [&] { sink = search.countIf(data, lambdaIn); });
+    double countSimd   = nsPerElement(n, reps, [&] { sink = search.countIf(data, Search::Between{ lo, hi }); });
+
+    if (search.findIf(data, lambdaEq).index != search.find(data, target).index ||
+        search.countIf(data, lambdaIn) != search.countIf(data, Search::Between{ lo, hi })) {
+        std::fprintf(stderr, "kernel and generic loop disagree\n");
+        std::exit(1);
+    }
+    std::printf("%-7s %10zu %9.3f %9.3f %9.3f %7.2fx %10.3f %9.3f %7.2fx\n", type, n, findLambda, stdFind, findSimd,
+                findLambda / findSimd, countLambda, countSimd, countLambda / countSimd);
+}
+
+int main(int argc, char** argv) {
+    int reps = argc > 1 ? std::atoi(argv[1]) : 20;
+    std::printf("ns per element\n");
+    std::printf("%-7s %10s %9s %9s %9s %8s %10s %9s %8s\n", "type", "n", "lambda", "std::find", "find", "speedup",
+                "count lam", "Between", "speedup");
+    for (std::size_t n : { std::size_t(50000), std::size_t(20000000) }) {
+        run<int>("int", n, reps);
+        run<float>("float", n, reps);
+        run<double>("double", n, reps);
+        run<long long>("int64", n, reps);
+    }
+    return 0;
+}
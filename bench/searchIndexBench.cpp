@@ -0,0 +1,55 @@
+#include "../search.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+/*
+    SearchIndex benchmark
+    Use: Random lookups on sorted ints with std::lower_bound, Search::binaryFind and
+         SearchIndex::lowerBound, from sizes that fit in L1 to sizes far past L2/L3.
+    Build: g++ -std=c++20 -O2 bench/searchIndexBench.cpp -o searchIndexBench
+    Run:   ./searchIndexBench [max size] [queries]   (default 100000000, 2000000)
+*/
+
+template <typename F>
+static double nsPerLookup(const std::vector<int>& queries, F f, std::size_t& sink) {
+    auto start = std::chrono::steady_clock::now();
+    for (int q : queries) sink += f(q);
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / static_cast<double>(queries.size());
+}
+
+int main(int argc, char** argv) {
+    std::size_t maxSize = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000000;
+    std::size_t queryCount = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 2000000;
+
+    std::mt19937 rng(11);
+    Search search;
+    std::size_t sink = 0;
+
+    std::printf("%12s %10s %16s %14s %14s %9s\n", "n", "bytes", "std::lower_bound", "binaryFind", "SearchIndex", "speedup");
+    for (std::size_t n = 1000; n <= maxSize; n *= 4) {
+        std::vector<int> data(n);
+        for (std::size_t i = 0; i < n; ++i) data[i] = static_cast<int>(2 * i);   // sorted, even numbers
+        SearchIndex index(data);
+
+        std::vector<int> queries(queryCount);
+        for (int& q : queries) q = static_cast<int>(rng() % (2 * n));           // half hits, half misses
+
+        std::size_t check = 0, checkIndex = 0;
+        double stdNs = nsPerLookup(queries, [&](int q) {
+            return static_cast<std::size_t>(std::lower_bound(data.begin(), data.end(), q) - data.begin());
+        }, check);
+        double binNs = nsPerLookup(queries, [&](int q) { return search.binaryFind(data, q).index; }, sink);
+        double idxNs = nsPerLookup(queries, [&](int q) { return index.lowerBound(q); }, checkIndex);
+        if (check != checkIndex) {
+            std::fprintf(stderr, "SearchIndex disagrees with std::lower_bound\n");
+            return 1;
+        }
+        std::printf("%12zu %9zuK %13.1f ns %11.1f ns %11.1f ns %8.2fx\n", n, n * sizeof(int) / 1024,
+                    stdNs, binNs, idxNs, stdNs / idxNs);
+    }
+    return sink == 42 ? 1 : 0;   // keeps sink alive
+}
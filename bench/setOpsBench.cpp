@@ -0,0 +1,126 @@
+#include "../setOps.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+/*
+    SetOps benchmark
+    Use: Sorted 32 bit id lists: intersect / unite / difference against std::set_*, for
+         similar sizes (merge, SIMD blocks for sparse ids) and skewed sizes (galloping), intersectMany over 8 lists,
+         and the unsorted hash intersect against a std::unordered_set loop.
+    Build: g++ -std=c++20 -O2 bench/setOpsBench.cpp -o setOpsBench
+    Run:   ./setOpsBench [big size] [repeats]   (default 10000000, 5)
+*/
+
+template <typename F>
+static double msFor(std::size_t repeats, F f) {
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t r = 0; r < repeats; ++r) f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / static_cast<double>(repeats);
+}
+
+// n distinct sorted ids drawn from [0, range)
+static std::vector<std::uint32_t> ids(std::mt19937& rng, std::size_t n, std::uint32_t range) {
+    std::vector<std::uint32_t> v(n);
+    for (auto& x : v) x = static_cast<std::uint32_t>(rng() % range);
+    std::sort(v.begin(), v.end());
+    v.erase(std::unique(v.begin(), v.end()), v.end());
+    return v;
+}
+
+static void check(bool ok) {
+    if (!ok) {
+        std::fprintf(stderr, "SetOps disagrees with the standard library\n");
+        std::exit(1);
+    }
+}
+
+int main(int argc, char** argv) {
+    std::size_t big = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    std::size_t repeats = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 5;
+    std::mt19937 rng(23);
+    SetOps ops;
+    std::vector<std::uint32_t> out(2 * big), ref(2 * big);
+
+    std::printf("%-34s %12s %12s %8s\n", "case", "std", "SetOps", "speedup");
+    auto row = [&](const char* label, double stdMs, double opsMs) {
+        std::printf("%-34s %9.3f ms %9.3f ms %7.2fx\n", label, stdMs, opsMs, stdMs / opsMs);
+    };
+
+    // similar sizes, about half of each list in common
+    auto a = ids(rng, big / 4, static_cast<std::uint32_t>(big / 2));
+    auto b = ids(rng, big / 4, static_cast<std::uint32_t>(big / 2));
+    std::size_t want = 0, got = 0;
+    double s = msFor(repeats, [&] { want = static_cast<std::size_t>(std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), ref.begin()) - ref.begin()); });
+    double o = msFor(repeats, [&] { got = ops.intersect(a, b, out).size(); });
+    check(want == got && std::equal(ref.begin(), ref.begin() + static_cast<std::ptrdiff_t>(want), out.begin()));
+    row("intersect, similar sizes", s, o);
+    auto sparseA = ids(rng, big / 4, static_cast<std::uint32_t>(big * 16));
+    auto sparseB = ids(rng, big / 4, static_cast<std::uint32_t>(big * 16));
+    s = msFor(repeats, [&] { want = static_cast<std::size_t>(std::set_intersection(sparseA.begin(), sparseA.end(), sparseB.begin(), sparseB.end(), ref.begin()) - ref.begin()); });
+    o = msFor(repeats, [&] { got = ops.intersect(sparseA, sparseB, out).size(); });
+    check(want == got && std::equal(ref.begin(), ref.begin() + static_cast<std::ptrdiff_t>(want), out.begin()));
+    row("intersect, similar sizes, sparse", s, o);
+    s = msFor(repeats, [&] { want = static_cast<std::size_t>(std::set_union(a.begin(), a.end(), b.begin(), b.end(), ref.begin()) - ref.begin()); });
+    o = msFor(repeats, [&] { got = ops.unite(a, b, out).size(); });
+    check(want == got);
+    row("unite, similar sizes", s, o);
+    s = msFor(repeats, [&] { want = static_cast<std::size_t>(std::set_difference(a.begin(), a.end(), b.begin(), b.end(), ref.begin()) - ref.begin()); });
+    o = msFor(repeats, [&] { got = ops.difference(a, b, out).size(); });
+    check(want == got);
+    row("difference, similar sizes", s, o);
+
+    // skewed: a short list against a long one
+    auto huge = ids(rng, big, static_cast<std::uint32_t>(big * 2));
+    for (std::size_t smallSize : { 100, 10000 }) {
+        auto small = ids(rng, smallSize, static_cast<std::uint32_t>(big * 2));
+        char label[64];
+        s = msFor(repeats, [&] { want = static_cast<std::size_t>(std::set_intersection(small.begin(), small.end(), huge.begin(), huge.end(), ref.begin()) - ref.begin()); });
+        o = msFor(repeats, [&] { got = ops.intersect(small, huge, out).size(); });
+        check(want == got);
+        std::snprintf(label, sizeof(label), "intersect %zu vs %zu", small.size(), huge.size());
+        row(label, s, o);
+        s = msFor(repeats, [&] { want = static_cast<std::size_t>(std::set_difference(huge.begin(), huge.end(), small.begin(), small.end(), ref.begin()) - ref.begin()); });
+        o = msFor(repeats, [&] { got = ops.difference(huge, small, out).size(); });
+        check(want == got);
+        std::snprintf(label, sizeof(label), "difference %zu - %zu", huge.size(), small.size());
+        row(label, s, o);
+    }
+
+    // 8 lists of growing size, pairwise std::set_intersection vs intersectMany
+    std::vector<std::vector<std::uint32_t>> lists;
+    for (std::size_t i = 0; i < 8; ++i) lists.push_back(ids(rng, big / 64 << (i / 2), static_cast<std::uint32_t>(big / 4)));
+    std::vector<std::uint32_t> tmp(big);
+    s = msFor(repeats, [&] {
+        want = lists[0].size();
+        std::copy(lists[0].begin(), lists[0].end(), ref.begin());
+        for (std::size_t i = 1; i < lists.size(); ++i) {
+            want = static_cast<std::size_t>(std::set_intersection(ref.begin(), ref.begin() + static_cast<std::ptrdiff_t>(want), lists[i].begin(), lists[i].end(), tmp.begin()) - tmp.begin());
+            std::copy(tmp.begin(), tmp.begin() + static_cast<std::ptrdiff_t>(want), ref.begin());
+        }
+    });
+    o = msFor(repeats, [&] { got = ops.intersectMany(lists, out).size(); });
+    check(want == got);
+    row("intersectMany, 8 lists", s, o);
+
+    // unsorted
+    auto ua = a, ub = b;
+    std::shuffle(ua.begin(), ua.end(), rng);
+    std::shuffle(ub.begin(), ub.end(), rng);
+    FlatHashSet<std::uint32_t> seen;
+    s = msFor(repeats, [&] {
+        std::unordered_set<std::uint32_t> set(ub.begin(), ub.end());
+        want = 0;
+        for (auto x : ua) {
+            if (set.count(x)) ref[want++] = x;
+        }
+    });
+    o = msFor(repeats, [&] { got = ops.intersectUnsorted(ua, ub, out, seen).size(); });
+    check(want == got);
+    row("intersectUnsorted vs unordered_set", s, o);
+    return 0;
+}
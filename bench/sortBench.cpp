@@ -0,0 +1,84 @@
+#include "../sorter.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+/*
+    Sorter benchmark
+    Use: Show that Sorter::introsort stays flat (about n log n) on the inputs
+         that used to make the first-element-pivot quicksort go quadratic,
+         and that Sorter::stablesort gets close to linear on presorted runs.
+         The introsort/stablesort columns pass a lambda so they time the comparison
+         engines; the radix column uses the default std::less, which picks the LSD radix sort.
+    Build: g++ -std=c++20 -O2 bench/sortBench.cpp -o sortBench
+    Run:   ./sortBench [max size]   (default 1000000)
+*/
+
+enum class Pattern { Random, Sorted, Reverse, OrganPipe, ManyDuplicates };
+
+static const char* patternName(Pattern p) {
+    switch (p) {
+        case Pattern::Random:         return "random";
+        case Pattern::Sorted:         return "sorted";
+        case Pattern::Reverse:        return "reverse";
+        case Pattern::OrganPipe:      return "organ-pipe";
+        case Pattern::ManyDuplicates: return "many-dups";
+    }
+    return "?";
+}
+
+static std::vector<int> makeInput(Pattern p, std::size_t n, std::mt19937& rng) {
+    std::vector<int> v(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        switch (p) {
+            case Pattern::Random:         v[i] = static_cast<int>(rng()); break;
+            case Pattern::Sorted:         v[i] = static_cast<int>(i); break;
+            case Pattern::Reverse:        v[i] = static_cast<int>(n - i); break;
+            case Pattern::OrganPipe:      v[i] = static_cast<int>(i < n / 2 ? i : n - i); break;
+            case Pattern::ManyDuplicates: v[i] = static_cast<int>(rng() % 16); break;
+        }
+    }
+    return v;
+}
+
+// Runs f on a fresh copy of input and returns the time per element in ns
+template <typename F>
+static double nsPerElement(const std::vector<int>& input, F f) {
+    std::vector<int> v = input;
+    auto start = std::chrono::steady_clock::now();
+    f(v);
+    auto stop = std::chrono::steady_clock::now();
+    if (!std::is_sorted(v.begin(), v.end())) {
+        std::fprintf(stderr, "output not sorted!\n");
+        std::exit(1);
+    }
+    return std::chrono::duration<double, std::nano>(stop - start).count() / static_cast<double>(input.size());
+}
+
+int main(int argc, char** argv) {
+    std::size_t maxSize = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    Sorter sorter;
+    std::mt19937 rng(42);
+    const Pattern patterns[] = { Pattern::Random, Pattern::Sorted, Pattern::Reverse,
+                                 Pattern::OrganPipe, Pattern::ManyDuplicates };
+
+    auto byValue = [](int a, int b) { return a < b; };
+
+    std::printf("%-12s %10s %14s %14s %14s %16s %14s\n", "pattern", "n", "introsort", "std::sort",
+                "stablesort", "std::stable_sort", "radix");
+    for (Pattern p : patterns) {
+        for (std::size_t n = 1000; n <= maxSize; n *= 10) {
+            std::vector<int> input = makeInput(p, n, rng);
+            double intro = nsPerElement(input, [&](std::vector<int>& v) { sorter.introsort(v, byValue); });
+            double stdSort = nsPerElement(input, [](std::vector<int>& v) { std::sort(v.begin(), v.end()); });
+            double stable = nsPerElement(input, [&](std::vector<int>& v) { sorter.stablesort(v, byValue); });
+            double stdStable = nsPerElement(input, [](std::vector<int>& v) { std::stable_sort(v.begin(), v.end()); });
+            double radix = nsPerElement(input, [&](std::vector<int>& v) { sorter.introsort(v); });
+            std::printf("%-12s %10zu %11.2f ns %11.2f ns %11.2f ns %13.2f ns %11.2f ns\n", patternName(p), n,
+                        intro, stdSort, stable, stdStable, radix);
+        }
+    }
+    return 0;
+}
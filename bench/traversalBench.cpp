@@ -0,0 +1,75 @@
+#include "../binaryTree.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+/*
+    binaryTree traversal benchmark
+    Use: Sum every value of a complete tree in each order with visit() (callback),
+         traverse() (iterator) and, as the baseline, the recursive walk binaryTree used to do.
+         Then the same on a list shaped tree that is too deep for recursion.
+    Build: g++ -std=c++20 -O2 bench/traversalBench.cpp -o traversalBench
+    Run:   ./traversalBench [n]   (default 10000000)
+*/
+
+static long long recursiveSum(const NodePool<Node>& pool, NodeIndex i) {
+    if (i == nilNode) return 0;
+    return pool[i].data + recursiveSum(pool, pool[i].left) + recursiveSum(pool, pool[i].right);
+}
+
+template <typename F>
+static double nsPerNode(std::size_t n, F f) {
+    auto start = std::chrono::steady_clock::now();
+    long long sum = f();
+    auto stop = std::chrono::steady_clock::now();
+    if (sum == 42) std::printf(" ");   // keeps the sum alive
+    return std::chrono::duration<double, std::nano>(stop - start).count() / static_cast<double>(n);
+}
+
+// Builds binaryTree's level order shape (or a left leaning list) straight in a shared pool
+static void build(NodePool<Node>& pool, binaryTree& tree, std::size_t n, bool list) {
+    tree.insertNode(0);   // root, index 0
+    for (std::size_t i = 1; i < n; ++i) {
+        NodeIndex k = pool.create(static_cast<int>(i % 1000));
+        NodeIndex parent = static_cast<NodeIndex>(list ? i - 1 : (i - 1) / 2);
+        if (list || i % 2 == 1) pool[parent].left = k;
+        else pool[parent].right = k;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    using Order = binaryTree::Order;
+    const char* names[] = { "level", "pre", "in", "post" };
+
+    for (int list = 0; list < 2; ++list) {
+        NodePool<Node> pool;
+        pool.reserve(n);
+        binaryTree tree(pool);
+        build(pool, tree, n, list == 1);
+
+        std::printf("%s, %zu nodes (ns per node)\n", list ? "list shaped (depth n)" : "complete tree", n);
+        if (!list) {
+            std::printf("  %-6s recursive %6.2f\n", "pre",
+                        nsPerNode(n, [&] { return recursiveSum(pool, 0); }));
+        } else {
+            std::printf("  recursive: skipped, %zu nested calls would overflow the stack\n", n);
+        }
+        for (int o = 0; o < 4; ++o) {
+            Order order = static_cast<Order>(o);
+            double visitNs = nsPerNode(n, [&] {
+                long long sum = 0;
+                tree.visit(order, [&](int v) { sum += v; });
+                return sum;
+            });
+            double iterNs = nsPerNode(n, [&] {
+                long long sum = 0;
+                for (int v : tree.traverse(order)) sum += v;
+                return sum;
+            });
+            std::printf("  %-6s visit %6.2f   iterator %6.2f\n", names[o], visitNs, iterNs);
+        }
+        std::printf("  search miss %6.2f\n", nsPerNode(n, [&] { return static_cast<long long>(tree.search(-1)); }));
+    }
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include "../balancedTree.h"
+#include "../binaryTree.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+
+/*
+    Tree benchmark
+    Use: BalancedTree vs std::map on random int keys: insert, find (hits and misses),
+         a sorted walk, range queries and erase. The old level order binaryTree is timed
+         at small sizes to show its O(n) per operation.
+    Build: g++ -std=c++20 -O2 bench/treeBench.cpp -o treeBench
+    Run:   ./treeBench [max size]   (default 10000000)
+*/
+
+static double msSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static volatile long long sink;
+
+template <typename InsertF, typename FindF, typename WalkF, typename RangeF, typename EraseF>
+static void row(const char* name, std::size_t n, InsertF insert, FindF find, WalkF walk, RangeF ranges, EraseF erase) {
+    auto t = std::chrono::steady_clock::now();
+    insert();
+    double ins = msSince(t);
+    t = std::chrono::steady_clock::now();
+    find();
+    double fnd = msSince(t);
+    t = std::chrono::steady_clock::now();
+    walk();
+    double wlk = msSince(t);
+    t = std::chrono::steady_clock::now();
+    ranges();
+    double rng = msSince(t);
+    t = std::chrono::steady_clock::now();
+    erase();
+    double ers = msSince(t);
+    auto per = [n](double ms) { return ms * 1e6 / static_cast<double>(n); };
+    std::printf("%-13s %10zu %9.1f %9.1f %9.2f %9.1f %9.1f\n", name, n, per(ins), per(fnd), per(wlk), per(rng), per(ers));
+}
+
+int main(int argc, char** argv) {
+    std::size_t maxSize = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    std::mt19937 rng(21);
+
+    std::printf("ns per key (ranges: n/100 queries of ~100 keys, reported per key of n)\n");
+    std::printf("%-13s %10s %9s %9s %9s %9s %9s\n", "", "n", "insert", "find", "walk", "range", "erase");
+    for (std::size_t n = 1000; n <= maxSize; n *= 10) {
+        std::vector<int> keys(n), probes(n);
+        for (int& k : keys) k = static_cast<int>(rng() & 0x7FFFFFFF);
+        for (int& k : probes) k = (rng() & 1) ? keys[rng() % n] : static_cast<int>(rng() & 0x7FFFFFFF);
+        int span = static_cast<int>(0x7FFFFFFF / n * 100);
+
+        {
+            BalancedTree<int, int> tree;
+            row("BalancedTree", n,
+                [&] { for (int k : keys) tree.insert(k, k); },
+                [&] { long long s = 0; for (int k : probes) s += tree.contains(k); sink = s; },
+                [&] { long long s = 0; for (auto [k, v] : tree) s += v; sink = s; },
+                [&] {
+                    long long s = 0;
+                    for (std::size_t q = 0; q < n / 100; ++q) {
+                        int lo = probes[q] & 0x3FFFFFFF;
+                        for (auto [k, v] : tree.range(lo, lo + span)) s += v;
+                    }
+                    sink = s;
+                },
+                [&] { for (int k : probes) tree.erase(k); });
+        }
+        {
+            std::map<int, int> map;
+            row("std::map", n,
+                [&] { for (int k : keys) map.insert({ k, k }); },
+                [&] { long long s = 0; for (int k : probes) s += map.count(k); sink = s; },
+                [&] { long long s = 0; for (auto& [k, v] : map) s += v; sink = s; },
+                [&] {
+                    long long s = 0;
+                    for (std::size_t q = 0; q < n / 100; ++q) {
+                        int lo = probes[q] & 0x3FFFFFFF;
+                        for (auto it = map.lower_bound(lo), stop = map.lower_bound(lo + span); it != stop; ++it) s += it->second;
+                    }
+                    sink = s;
+                },
+                [&] { for (int k : probes) map.erase(k); });
+        }
+        if (n <= 10000) {
+            binaryTree old;
+            row("binaryTree", n,
+                [&] { for (int k : keys) old.insertNode(k); },
+                [&] { long long s = 0; for (int k : probes) s += old.search(k); sink = s; },
+                [] {}, [] {},
+                [&] { for (std::size_t i = 0; i < n / 10; ++i) old.deleteNode(probes[i]); });
+        }
+    }
+    return 0;
+}
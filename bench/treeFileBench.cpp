@@ -0,0 +1,63 @@
+#include "../treeFile.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+/*
+    binaryTree startup benchmark
+    Use: Time until a tree of n keys is ready for lookups: n insertNode calls, buildFromSorted
+         from the sorted keys, and MappedTree::open of a saved file (with and without
+         verify), plus the first 1000 searches on the mapped file.
+    Build: g++ -std=c++20 -O2 bench/treeFileBench.cpp -o treeFileBench
+    Run:   ./treeFileBench [max size] [file]   (default 10000000, treeFileBench.bt)
+*/
+
+template <typename F>
+static double msFor(F f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    std::size_t maxSize = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    std::string path = argc > 2 ? argv[2] : "treeFileBench.bt";
+    std::mt19937 rng(17);
+    std::size_t sink = 0;
+
+    std::printf("%10s %10s %12s %15s %12s %12s %14s\n", "n", "file", "insertNode", "buildFromSorted",
+                "mmap open", "open+verify", "1000 searches");
+    for (std::size_t n = 1000; n <= maxSize; n *= 10) {
+        std::vector<int> keys(n);
+        for (int& k : keys) k = static_cast<int>(rng());
+        Sorter().introsort(keys);
+
+        char insertMs[32] = "-";
+        if (n <= 10000) {
+            binaryTree tree;
+            std::snprintf(insertMs, sizeof(insertMs), "%.3f ms", msFor([&] { for (int k : keys) tree.insertNode(k); }));
+        }
+        binaryTree bulk;
+        double bulkMs = msFor([&] { bulk.buildFromSorted(keys); });
+        if (!TreeFile::save(bulk, path)) {
+            std::fprintf(stderr, "can't write %s\n", path.c_str());
+            return 1;
+        }
+
+        MappedTree mapped;
+        double openMs = msFor([&] { mapped.open(path); });
+        double searchMs = msFor([&] { for (int i = 0; i < 1000; ++i) sink += mapped.search(keys[rng() % n]); });
+        MappedTree checked;
+        double verifyMs = msFor([&] { checked.open(path, true); });
+        if (!mapped.isOpen() || !checked.isOpen() || mapped.size() != n) {
+            std::fprintf(stderr, "MappedTree failed: %s\n", checked.error() ? checked.error() : "wrong size");
+            return 1;
+        }
+        std::printf("%10zu %9zuK %12s %12.3f ms %9.3f ms %9.3f ms %11.3f ms\n", n,
+                    (sizeof(TreeFileHeader) + n * sizeof(Node)) / 1024, insertMs, bulkMs, openMs, verifyMs, searchMs);
+    }
+    std::remove(path.c_str());
+    return sink == 42 ? 1 : 0;   // keeps sink alive
+}
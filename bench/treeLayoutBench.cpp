@@ -0,0 +1,125 @@
+#include "../binaryTree.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <vector>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+/*
+    binaryTree node layout benchmark
+    Use: Memory footprint and full-traversal time of the old layout (one new Node per insert,
+         8 byte child pointers) vs the NodePool layout (one array, 32 bit child indices).
+         Both trees have binaryTree's shape (complete, level order). The pointer layout is
+         measured twice: nodes allocated in level order (best case, a fresh heap) and in
+         shuffled order (what a long running process with a fragmented heap looks like).
+         Traversal = the recursive search binaryTree does for a key that is not there.
+    Build: g++ -std=c++20 -O2 bench/treeLayoutBench.cpp -o treeLayoutBench
+    Run:   ./treeLayoutBench [max size]   (default 10000000)
+*/
+
+// The layout binaryTree had before NodePool
+struct PtrNode {
+    int data;
+    PtrNode* left;
+    PtrNode* right;
+};
+
+static std::size_t heapInUse() {
+#if defined(__GLIBC__)
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+static bool searchPtr(const PtrNode* n, int value) {
+    if (n == nullptr) return false;
+    if (n->data == value) return true;
+    return searchPtr(n->left, value) || searchPtr(n->right, value);
+}
+
+static bool searchPool(const NodePool<Node>& pool, NodeIndex i, int value) {
+    if (i == nilNode) return false;
+    if (pool[i].data == value) return true;
+    return searchPool(pool, pool[i].left, value) || searchPool(pool, pool[i].right, value);
+}
+
+template <typename F>
+static double nsPerNode(std::size_t n, F f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / static_cast<double>(n);
+}
+
+// Complete tree in level order: node i has children 2i+1 and 2i+2, like n insertNode calls
+static PtrNode* buildPtr(std::size_t n, bool shuffled, std::vector<PtrNode*>& all, std::mt19937& rng) {
+    all.assign(n, nullptr);
+    std::vector<std::size_t> order(n);
+    std::iota(order.begin(), order.end(), std::size_t(0));
+    if (shuffled) std::shuffle(order.begin(), order.end(), rng);
+    for (std::size_t i : order) all[i] = new PtrNode{ static_cast<int>(i), nullptr, nullptr };
+    for (std::size_t i = 0; i < n; ++i) {
+        if (2 * i + 1 < n) all[i]->left = all[2 * i + 1];
+        if (2 * i + 2 < n) all[i]->right = all[2 * i + 2];
+    }
+    return all[0];
+}
+
+static void buildPool(std::size_t n, NodePool<Node>& pool) {
+    for (std::size_t i = 0; i < n; ++i) pool.create(static_cast<int>(i));
+    for (std::size_t i = 0; i < n; ++i) {
+        if (2 * i + 1 < n) pool[static_cast<NodeIndex>(i)].left = static_cast<NodeIndex>(2 * i + 1);
+        if (2 * i + 2 < n) pool[static_cast<NodeIndex>(i)].right = static_cast<NodeIndex>(2 * i + 2);
+    }
+}
+
+int main(int argc, char** argv) {
+    std::size_t maxSize = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    std::mt19937 rng(3);
+
+    std::printf("%10s | %-22s | %-22s | %-22s | %s\n", "", "new Node, level order", "new Node, shuffled", "NodePool", "");
+    std::printf("%10s | %9s %12s | %9s %12s | %9s %12s | %s\n", "n", "B/node", "ns/node", "B/node", "ns/node",
+                "B/node", "ns/node", "teardown ptr vs pool");
+    for (std::size_t n = 10000; n <= maxSize; n *= 10) {
+        double ptrBytes[2], ptrNs[2], ptrFree = 0;
+        for (int shuffled = 0; shuffled < 2; ++shuffled) {
+            std::vector<PtrNode*> all;
+            std::size_t before = heapInUse();
+            PtrNode* root = buildPtr(n, shuffled == 1, all, rng);
+            ptrBytes[shuffled] = static_cast<double>(heapInUse() - before) / static_cast<double>(n);
+            ptrNs[shuffled] = nsPerNode(n, [&] { if (searchPtr(root, -1)) std::abort(); });
+            auto start = std::chrono::steady_clock::now();
+            for (PtrNode* p : all) delete p;   // what a destructor would have to do
+            ptrFree = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        double poolBytes, poolNs, poolFree;
+        {
+            auto* pool = new NodePool<Node>();
+            std::size_t before = heapInUse();
+            pool->reserve(n);
+            buildPool(n, *pool);
+            poolBytes = static_cast<double>(heapInUse() - before) / static_cast<double>(n);
+            poolNs = nsPerNode(n, [&] { if (searchPool(*pool, 0, -1)) std::abort(); });
+            auto start = std::chrono::steady_clock::now();
+            delete pool;
+            poolFree = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        std::printf("%10zu | %9.1f %12.2f | %9.1f %12.2f | %9.1f %12.2f | %.2f ms vs %.3f ms\n", n, ptrBytes[0], ptrNs[0],
+                    ptrBytes[1], ptrNs[1], poolBytes, poolNs, ptrFree, poolFree);
+    }
+
+    // Sanity check on the real class at a size its O(n) insert can still build
+    binaryTree tree;
+    for (int i = 0; i < 20000; ++i) tree.insertNode(i);
+    double treeNs = nsPerNode(20000, [&] { if (tree.search(-1)) std::abort(); });
+    std::printf("\nbinaryTree (NodePool), 20000 nodes: %.2f ns/node traversal, %zu bytes\n", treeNs, tree.memoryBytes());
+    return 0;
+}
@@ -1,151 +1,553 @@
+#pragma once
+#include <algorithm>    // std::merge, std::is_sorted, std::max
+#include <cstddef>      // std::size_t, std::ptrdiff_t
 #include <iostream>
+#include <iterator>     // std::default_sentinel_t
 #include <queue>
-using namespace std;
+#include <ranges>
+#include <span>
+#include <thread>       // std::thread::hardware_concurrency
+#include <type_traits>  // std::invoke_result_t
+#include <vector>
+#include "nodePool.h"
+#include "sorter.h"
+#include "threadPool.h"
+// NOT USING NAMESPACE STD FOR MORE ROBUST CODE
 
 /* 
     ============== LEARNING ================
     Re-visit binary Tree project for class, 
     .h file, and pointer information
     ========================================
+    For real key lookups use BalancedTree (balancedTree.h):
+    ordered, self-balancing, O(log n) insert/search/delete.
+
+    Nodes come from a NodePool (nodePool.h): one array, children are
+    32 bit indices (nilNode = no child) instead of pointers.
+    A tree owns its pool unless you hand it one to share, e.g.
+        NodePool<Node> arena;
+        binaryTree a(arena), b(arena);
+        ...
+        arena.clear();   // a and b are gone in one go
+    Copying a tree never shares nodes: the copy of a or b gets its own pool.
+
+    Traversals don't recurse and don't print: visit(order, f) calls f on every
+    value, traverse(order) gives an iterator range. Orders: level, pre, in, post.
+
+    Bulk loading: binaryTree(sortedValues) / buildFromSorted builds a perfectly
+    balanced tree (in order = sorted) in O(n) in one block of the pool, optionally
+    on a ThreadPool. insertSorted merges another sorted batch in, O(n + m).
+    insertNode keeps its level order behaviour.
+
+    Saving: TreeFile::save(tree, path) writes the tree as a flat node array,
+    MappedTree (treeFile.h) maps that file and searches/walks it in place.
 */
 
+using NodeIndex = NodePool<int>::Index;
+constexpr NodeIndex nilNode = NodePool<int>::nil;
+
 class Node {
 public: 
     int data;
-    Node* left;
-    Node* right;
+    NodeIndex left;
+    NodeIndex right;
 
-    Node(int value) : data(value), left(nullptr), right(nullptr) {}
+    Node(int value) : data(value), left(nilNode), right(nilNode) {}
 };
 
-class binaryTree {
-    Node* root;
-
-    Node* deleteRecursive(Node* current, int value) {
-        // Base case:
-        // If the current subtree is empty, there is nothing to delete.
-        if (current == nullptr) return nullptr;
-
-        // Case 1: The current node contains the value to be deleted.
-        if (current->data == value) {
-            // Case 1a: Node is a leaf (no children).
-            // Safe to delete directly and return null to the parent.
-            if (current->left == nullptr && current->right == nullptr) {
-                delete current;
-                return nullptr;
+enum class TreeOrder { level, pre, in, post };
+
+// Traversal over a Node array (a NodePool's slots or a mapped tree file), shared by
+// binaryTree's visit()/iterators and MappedTree. The walk keeps an explicit stack (a queue
+// for level order) that grows like a vector, so stepping allocates nothing once it has
+// grown to the tree's height (its widest level for level order).
+struct TreeWalker {
+    using Order = TreeOrder;
+
+    const Node* nodes;
+    std::vector<NodeIndex> pending;
+    std::size_t head = 0;          // level order: front of the queue
+    NodeIndex at = nilNode;        // node the walk is on, nilNode once it is done
+    NodeIndex lastOut = nilNode;   // post order: node handed out last
+
+    void pushLeftChain(NodeIndex i) {
+        while (i != nilNode) {
+            pending.push_back(i);
+            i = nodes[i].left;
+        }
+    }
+
+    template <Order O>
+    void start(NodeIndex root) {
+        if constexpr (O == Order::in || O == Order::post) pushLeftChain(root);
+        else if (root != nilNode) pending.push_back(root);
+        step<O>();
+    }
+
+    template <Order O>
+    void step() {
+        const Node* p = nodes;
+        if constexpr (O == Order::level) {
+            if (head == pending.size()) { at = nilNode; return; }
+            at = pending[head++];
+            if (p[at].left != nilNode) pending.push_back(p[at].left);
+            if (p[at].right != nilNode) pending.push_back(p[at].right);
+            // drop the consumed front once it is most of the buffer (amortized O(1))
+            if (head >= 1024 && head * 2 >= pending.size()) {
+                pending.erase(pending.begin(), pending.begin() + static_cast<std::ptrdiff_t>(head));
+                head = 0;
             }
-            // Case 1b: Node has only a right child.
-            // Replace the node with its right subtree.
-            if (current->left == nullptr) {
-                Node* temp = current->right;
-                delete current;
-                return temp;
+        }
+        else if constexpr (O == Order::pre) {
+            if (pending.empty()) { at = nilNode; return; }
+            at = pending.back();
+            pending.pop_back();
+            if (p[at].right != nilNode) pending.push_back(p[at].right);
+            if (p[at].left != nilNode) pending.push_back(p[at].left);
+        }
+        else if constexpr (O == Order::in) {
+            if (pending.empty()) { at = nilNode; return; }
+            at = pending.back();
+            pending.pop_back();
+            pushLeftChain(p[at].right);
+        }
+        else {
+            // Left subtree is done when a node reaches the top; go right unless
+            // the right subtree is what we just finished
+            while (!pending.empty()) {
+                NodeIndex top = pending.back();
+                NodeIndex right = p[top].right;
+                if (right != nilNode && right != lastOut) {
+                    pushLeftChain(right);
+                    continue;
+                }
+                pending.pop_back();
+                at = lastOut = top;
+                return;
             }
-            // Case 1c: Node has only a left child.
-            // Replace the node with its left subtree.
-            if (current->right == nullptr) {
-                Node* temp = current->left;
-                delete current;
-                return temp;
+            at = nilNode;
+        }
+    }
+
+    // f(data), or f(data) -> bool where false stops the walk
+    template <typename F>
+    static bool keepGoing(F& f, int data) {
+        if constexpr (std::is_same_v<std::invoke_result_t<F&, int>, bool>) return f(data);
+        else {
+            f(data);
+            return true;
+        }
+    }
+
+    template <Order O, typename F>
+    static bool walk(const Node* nodes, NodeIndex root, F& f) {
+        TreeWalker w{ nodes, {} };
+        for (w.template start<O>(root); w.at != nilNode; w.template step<O>()) {
+            if (!keepGoing(f, nodes[w.at].data)) return false;
+        }
+        return true;
+    }
+
+    // Calls f(data) for every node in the given order, false if f stopped it early.
+    // The loop is a template per order, so f gets inlined.
+    template <typename F>
+    static bool visit(const Node* nodes, NodeIndex root, Order order, F&& f) {
+        switch (order) {
+        case Order::level: return walk<Order::level>(nodes, root, f);
+        case Order::pre:   return walk<Order::pre>(nodes, root, f);
+        case Order::in:    return walk<Order::in>(nodes, root, f);
+        default:           return walk<Order::post>(nodes, root, f);
+        }
+    }
+};
+
+// Input iterator over the node values: for (int v : tree.traverse(binaryTree::Order::in))
+class TreeIterator {
+    TreeWalker w;
+    TreeOrder order;
+
+public:
+    using iterator_concept = std::input_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+    using value_type = int;
+    using difference_type = std::ptrdiff_t;
+
+    TreeIterator(const Node* nodes, NodeIndex root, TreeOrder o) : w{ nodes, {} }, order(o) {
+        switch (order) {
+        case TreeOrder::level: w.start<TreeOrder::level>(root); break;
+        case TreeOrder::pre:   w.start<TreeOrder::pre>(root); break;
+        case TreeOrder::in:    w.start<TreeOrder::in>(root); break;
+        default:               w.start<TreeOrder::post>(root); break;
+        }
+    }
+
+    int operator*() const { return w.nodes[w.at].data; }
+    TreeIterator& operator++() {
+        switch (order) {
+        case TreeOrder::level: w.step<TreeOrder::level>(); break;
+        case TreeOrder::pre:   w.step<TreeOrder::pre>(); break;
+        case TreeOrder::in:    w.step<TreeOrder::in>(); break;
+        default:               w.step<TreeOrder::post>(); break;
+        }
+        return *this;
+    }
+    void operator++(int) { ++*this; }
+    bool operator==(std::default_sentinel_t) const { return w.at == nilNode; }
+};
+
+struct TreeTraversal {
+    const Node* nodes;
+    NodeIndex root;
+    TreeOrder order;
+    TreeIterator begin() const { return TreeIterator(nodes, root, order); }
+    std::default_sentinel_t end() const { return {}; }
+};
+
+
+class binaryTree {
+public:
+    using Order = TreeOrder;
+    using iterator = TreeIterator;
+    using Traversal = TreeTraversal;
+
+private:
+    NodePool<Node> ownNodes;
+    NodePool<Node>* sharedNodes = nullptr;   // set when the tree lives in someone else's pool
+    NodeIndex root;
+
+    NodePool<Node>& nodes() { return sharedNodes ? *sharedNodes : ownNodes; }
+    const NodePool<Node>& nodes() const { return sharedNodes ? *sharedNodes : ownNodes; }
+
+    // Same cases as the old recursive delete, but the "still to look at" subtrees go on an
+    // explicit stack, so a degenerate (list shaped) tree can't blow the call stack.
+    // Each entry is the link that points at a subtree plus the value to delete in it.
+    void deleteIterative(int value) {
+        NodePool<Node>& pool = nodes();
+        struct Pending {
+            NodeIndex* link;
+            int value;
+        };
+        std::vector<Pending> work;
+        work.push_back({ &root, value });
+
+        // destroy() never moves the array, so links into it stay valid during the walk
+        while (!work.empty()) {
+            Pending job = work.back();
+            work.pop_back();
+            NodeIndex current = *job.link;
+
+            // Base case:
+            // If the current subtree is empty, there is nothing to delete.
+            if (current == nilNode) continue;
+
+            Node& node = pool[current];
+            // Case 1: The current node contains the value to be deleted.
+            if (node.data == job.value) {
+                // Case 1a: Node is a leaf (no children).
+                // Safe to delete directly and point the parent at nothing.
+                if (node.left == nilNode && node.right == nilNode) {
+                    *job.link = nilNode;
+                    pool.destroy(current);
+                }
+                // Case 1b: Node has only a right child.
+                // Replace the node with its right subtree.
+                else if (node.left == nilNode) {
+                    *job.link = node.right;
+                    pool.destroy(current);
+                }
+                // Case 1c: Node has only a left child.
+                // Replace the node with its left subtree.
+                else if (node.right == nilNode) {
+                    *job.link = node.left;
+                    pool.destroy(current);
+                }
+                // Case 1d: Node has two children.
+                else {
+                    // Find the inorder successor (smallest value in right subtree).
+                    NodeIndex successor = findMin(node.right);
+                    // Copy the successor's value into the current node.
+                    node.data = pool[successor].data;
+                    // Delete the successor value from the right subtree.
+                    work.push_back({ &node.right, node.data });
+                }
             }
+            else {
+                // Case 2: Current node does not match the value.
+                // Continue searching both subtrees.
+                work.push_back({ &node.right, job.value });
+                work.push_back({ &node.left, job.value });
+            }
+        }
+    }
+
+    NodeIndex findMin(NodeIndex node) const {
+        const NodePool<Node>& pool = nodes();
+        while (pool[node].left != nilNode) node = pool[node].left;
+        return node;
+    }
+
+    // Subtrees below this size are built on the current thread
+    static constexpr std::size_t parallelGrain = 1 << 16;
 
-            // Case 1d: Node has two children.
-            // Find the inorder successor (smallest value in right subtree).
-            Node* successor = findMin(current->right);
+    // Writes the balanced tree for sorted[0, count) into out[base, base + count) in pre-order:
+    // middle value at base, left half right after it, right half after that. Every subtree
+    // owns its own slice of the block, so the halves can be built on different threads.
+    static void buildRange(Node* out, NodeIndex base, const int* sorted, std::size_t count, ThreadPool* threads) {
+        if (count == 0) return;
+        std::size_t mid = count / 2;
+        std::size_t rightCount = count - mid - 1;
+        NodeIndex leftBase = base + 1;
+        NodeIndex rightBase = base + 1 + static_cast<NodeIndex>(mid);
 
-            // Copy the successor's value into the current node.
-            current->data = successor->data;
+        Node& node = out[base];
+        node.data = sorted[mid];
+        node.left = mid ? leftBase : nilNode;
+        node.right = rightCount ? rightBase : nilNode;
 
-            // Recursively delete the successor node from the right subtree.
-            current->right = deleteRecursive(current->right, successor->data);
+        if (threads && count > parallelGrain) {
+            ThreadPool::TaskGroup group(*threads);
+            group.run([=] { buildRange(out, leftBase, sorted, mid, threads); });
+            buildRange(out, rightBase, sorted + mid + 1, rightCount, threads);
+            group.wait();
         }
         else {
-            // Case 2: Current node does not match the value.
-            // Continue searching both subtrees recursively.
-            current->left = deleteRecursive(current->left, value);
-            current->right = deleteRecursive(current->right, value);
+            buildRange(out, leftBase, sorted, mid, nullptr);
+            buildRange(out, rightBase, sorted + mid + 1, rightCount, nullptr);
         }
-        // Return the (possibly updated) root of this subtree.
-        return current;
     }
 
-    Node* findMin(Node* node) {
-        while (node->left != nullptr) node = node->left;
-        return node;
+    // Gives back every node of this tree. Own pool: one clear(). Shared pool: each node
+    // goes on the pool's free list (other trees in the pool stay as they are).
+    void releaseAll() {
+        NodePool<Node>& pool = nodes();
+        if (!sharedNodes) pool.clear();
+        else {
+            TreeWalker w{ pool.data(), {} };
+            for (w.start<Order::pre>(root); w.at != nilNode; w.step<Order::pre>()) pool.destroy(w.at);
+        }
+        root = nilNode;
+    }
+
+    void build(std::span<const int> sorted, ThreadPool* threads) {
+        releaseAll();
+        if (sorted.empty()) return;
+        NodePool<Node>& pool = nodes();
+        NodeIndex first = pool.appendBlock(sorted.size(), Node(0));
+        buildRange(pool.data(), first, sorted.data(), sorted.size(), threads);
+        root = first;
+    }
+
+    // Values in order, sorted (they already are for a tree that came from buildFromSorted)
+    std::vector<int> sortedValues() const {
+        std::vector<int> values;
+        values.reserve(nodeCount());
+        visit(Order::in, [&](int v) { values.push_back(v); });
+        if (!std::is_sorted(values.begin(), values.end())) Sorter().introsort(values);
+        return values;
     }
 
-    bool searchRecursive(Node* current, int value) {
-        // no data, return false for not found
-        if (current == nullptr) return false;
-        // This node has the data, return true for having found the data
-        if (current->data == value) return true;
-        // If it's not in this node, search the node's children
-        return searchRecursive(current->left, value) || searchRecursive(current->right, value);
+    template <typename R>
+    static std::span<const int> contiguous(const R& range, std::vector<int>& copy) {
+        if constexpr (std::ranges::contiguous_range<R>) return std::span<const int>(std::ranges::data(range), std::ranges::size(range));
+        else {
+            copy.assign(std::ranges::begin(range), std::ranges::end(range));
+            return copy;
+        }
     }
 
 public:
     // Constructor
-    binaryTree() : root(nullptr) {}
+    binaryTree() : root(nilNode) {}
+    // Bulk load: balanced tree from values sorted ascending, O(n)
+    template <typename R> requires std::ranges::input_range<R>
+    explicit binaryTree(const R& sortedValues) : root(nilNode) { buildFromSorted(sortedValues); }
+    // Tree whose nodes live in a pool shared with other trees (the pool must outlive the tree)
+    explicit binaryTree(NodePool<Node>& pool) : sharedNodes(&pool), root(nilNode) {}
+
+    // Own pool: every node goes away with the pool's one array, no walk over the tree.
+    // Shared pool: nodes stay until the pool is cleared or destroyed.
+    ~binaryTree() = default;
+
+    // A copy always gets its own nodes. Own pool: the pool array is copied as is (one memcpy).
+    // Shared pool: only this tree's nodes are copied, packed into the copy's own pool, so
+    // changing the copy never touches (or grows) the shared pool.
+    binaryTree(const binaryTree& other) : root(nilNode) {
+        if (!other.sharedNodes) {
+            ownNodes = other.ownNodes;
+            root = other.root;
+        }
+        else assignPacked(other.packedNodes());
+    }
+    // Moving hands over the nodes (own pool or place in the shared pool), other ends up empty
+    binaryTree(binaryTree&& other) noexcept
+        : ownNodes(std::move(other.ownNodes)), sharedNodes(other.sharedNodes), root(other.root) {
+        other.root = nilNode;
+    }
+    // Assignment keeps this tree's storage: own pool, or its place in its shared pool
+    binaryTree& operator=(const binaryTree& other) {
+        if (this == &other) return *this;
+        if (!sharedNodes && !other.sharedNodes) {
+            ownNodes = other.ownNodes;
+            root = other.root;
+        }
+        else assignPacked(other.packedNodes());
+        return *this;
+    }
+    binaryTree& operator=(binaryTree&& other) {
+        if (this == &other) return *this;
+        if (!sharedNodes && !other.sharedNodes) {
+            ownNodes = std::move(other.ownNodes);
+            root = other.root;
+        }
+        else if (sharedNodes == other.sharedNodes) {
+            releaseAll();
+            root = other.root;
+        }
+        else {
+            assignPacked(other.packedNodes());
+            other.releaseAll();
+        }
+        other.root = nilNode;
+        return *this;
+    }
 
     void insertNode(int value) {
-        Node* newNode = new Node(value);
+        NodePool<Node>& pool = nodes();
+        NodeIndex newNode = pool.create(value);
 
-        if (root == nullptr) {
+        if (root == nilNode) {
             root = newNode;
             return;
         }
 
-        queue<Node*> q;
+        std::queue<NodeIndex> q;
         q.push(root);
 
         while(!q.empty()) {
-            Node* current = q.front();
+            NodeIndex current = q.front();
             q.pop();
 
-            if (current->left == nullptr) {
-                current->left = newNode;
+            if (pool[current].left == nilNode) {
+                pool[current].left = newNode;
                 return;
             }
             else {
-                q.push(current->left);
+                q.push(pool[current].left);
             }
 
-            if (current->right == nullptr) {
-                current->right = newNode;
+            if (pool[current].right == nilNode) {
+                pool[current].right = newNode;
                 return;
             }
             else {
-                q.push(current->right);
+                q.push(pool[current].right);
             }
         }
     }
 
-    // Hides deleteRecursive from the user
+    // Replaces the tree with a perfectly balanced one holding sortedValues (ascending),
+    // O(n) and one contiguous block of nodes. Any input range works, spans/vectors/arrays are not copied.
+    template <typename R> requires std::ranges::input_range<R>
+    void buildFromSorted(const R& sortedValues) {
+        std::vector<int> copy;
+        build(contiguous(sortedValues, copy), nullptr);
+    }
+
+    // Same, with the two halves of every big subtree built on different threads
+    template <typename R> requires std::ranges::input_range<R>
+    void buildFromSorted(const R& sortedValues, ThreadPool& threads) {
+        std::vector<int> copy;
+        build(contiguous(sortedValues, copy), &threads);
+    }
+    // threadCount counts the calling thread like Sorter's parallel sorts: 1 = serial, 0 = all cores
+    template <typename R> requires std::ranges::input_range<R>
+    void buildFromSorted(const R& sortedValues, std::size_t threadCount) {
+        if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+        if (threadCount == 1) return buildFromSorted(sortedValues);
+        ThreadPool threads(threadCount - 1);   // the calling thread is the last one
+        buildFromSorted(sortedValues, threads);
+    }
+
+    // Merges a sorted batch into the tree and rebuilds it balanced: O(n + m) when the tree
+    // came from buildFromSorted, O(n log n) for a level order tree (its values get sorted first)
+    template <typename R> requires std::ranges::input_range<R>
+    void insertSorted(const R& sortedBatch) {
+        std::vector<int> copy;
+        std::span<const int> batch = contiguous(sortedBatch, copy);
+        std::vector<int> current = sortedValues();
+        std::vector<int> merged(current.size() + batch.size());
+        std::merge(current.begin(), current.end(), batch.begin(), batch.end(), merged.begin());
+        build(merged, nullptr);
+    }
+
+    // Hides deleteIterative from the user
     void deleteNode(int value) {
-        root = deleteRecursive(root, value);
+        deleteIterative(value);
     }
 
-    // Same as delete
-    bool search(int value) {
-        return searchRecursive(root, value);
+    // Pre-order walk that stops at the first match (no recursion, any tree depth is fine)
+    bool search(int value) const {
+        return !visit(Order::pre, [value](int data) { return data != value; });
     }
 
-    // levelOrder function made possible by inserting the nodes into the queue initially
-    void levelOrder() {
-        if (root == nullptr) return;
+    // Calls f(data) for every node in the given order. f can return bool, false stops early.
+    // Returns false if f stopped it. The loop is a template per order, so f gets inlined.
+    template <typename F>
+    bool visit(Order order, F&& f) const {
+        return TreeWalker::visit(nodes().data(), root, order, f);
+    }
 
-        queue<Node*> q;
-        q.push(root);
+    // Input iterator over the node values: for (int v : tree.traverse(binaryTree::Order::in))
+    Traversal traverse(Order order) const { return { nodes().data(), root, order }; }
 
-        while (!q.empty()) {
-            Node* current = q.front();
-            q.pop();
+    // levelOrder prints the tree level by level (same order the nodes were inserted in)
+    void levelOrder() const {
+        if (root == nilNode) return;
+        visit(Order::level, [](int data) { std::cout << data << " "; });
+        std::cout << std::endl;
+    }
+
+    // Copy of this tree's nodes only, renumbered in pre-order: root at 0 and every child
+    // after its parent, no free slots. This is the layout treeFile.h saves and maps.
+    std::vector<Node> packedNodes() const {
+        const NodePool<Node>& pool = nodes();
+        std::vector<NodeIndex> newIndex(pool.slotCount(), nilNode);
+        std::vector<NodeIndex> preOrder;
+        TreeWalker w{ pool.data(), {} };
+        for (w.start<Order::pre>(root); w.at != nilNode; w.step<Order::pre>()) {
+            newIndex[w.at] = static_cast<NodeIndex>(preOrder.size());
+            preOrder.push_back(w.at);
+        }
 
-            cout << current->data << " ";
+        std::vector<Node> packed;
+        packed.reserve(preOrder.size());
+        for (NodeIndex old : preOrder) {
+            Node n = pool[old];
+            if (n.left != nilNode) n.left = newIndex[n.left];
+            if (n.right != nilNode) n.right = newIndex[n.right];
+            packed.push_back(n);
+        }
+        return packed;
+    }
 
-            if (current->left != nullptr) q.push(current->left);
-            if (current->right != nullptr) q.push(current->right);
+    // Replaces the tree with nodes laid out like packedNodes() (root at 0, links into the
+    // same array), copied into one block of the pool
+    void assignPacked(std::span<const Node> packed) {
+        releaseAll();
+        if (packed.empty()) return;
+        NodePool<Node>& pool = nodes();
+        NodeIndex first = pool.appendBlock(packed.size(), Node(0));
+        Node* out = pool.data() + first;
+        for (std::size_t i = 0; i < packed.size(); ++i) {
+            Node n = packed[i];
+            if (n.left != nilNode) n.left += first;
+            if (n.right != nilNode) n.right += first;
+            out[i] = n;
         }
-        cout << endl;
+        root = first;
     }
+
+    // Nodes in the tree's own pool; for a shared pool, every tree in it
+    std::size_t nodeCount() const { return nodes().size(); }
+    std::size_t memoryBytes() const { return nodes().bytes(); }
 }; 
\ No newline at end of file
@@ -0,0 +1,105 @@
+#pragma once
+#include <cstddef>      // std::size_t
+#include <cstdint>
+#include <cstring>      // std::memcpy
+#include <string>
+#include <string_view>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+// NOT USING NAMESPACE STD FOR MORE ROBUST CODE
+
+/*
+CaseFold
+    Use: Case insensitive compare/equal for ASCII strings without copying them.
+    Steps: Walk both strings 16 bytes at a time (SSE2) or 8 at a time (plain 64 bit math),
+           lower case the block, stop at the first block that differs.
+    Notes:
+        - Same order the old transform(::tolower) + operator< compares gave in the "C" locale:
+          compare byte by byte as unsigned char after 'A'-'Z' -> 'a'-'z', shorter string first on a tie.
+        - Bytes >= 0x80 are left alone (no UTF-8 case folding).
+*/
+
+class CaseFold {
+private:
+    static unsigned char lowerByte(unsigned char c) {
+        return (c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c | 0x20) : c;
+    }
+
+    // Lower cases 8 bytes at once: only bytes in 'A'..'Z' get 0x20 added
+    static std::uint64_t lower8(std::uint64_t x) {
+        constexpr std::uint64_t ones = 0x0101010101010101ULL;
+        std::uint64_t low7    = x & (0x7F * ones);
+        std::uint64_t atLeastA = low7 + (0x80 - 'A') * ones;       // high bit set if byte >= 'A'
+        std::uint64_t aboveZ   = low7 + (0x80 - 'Z' - 1) * ones;   // high bit set if byte >  'Z'
+        std::uint64_t upper    = (atLeastA ^ aboveZ) & ~x & (0x80 * ones);
+        return x | (upper >> 2);
+    }
+
+    // Index of the first byte where the folded blocks differ, or n if all n bytes match
+    static std::size_t firstDifference(const char* a, const char* b, std::size_t n) {
+        std::size_t i = 0;
+#if defined(__SSE2__)
+        const __m128i bias  = _mm_set1_epi8(static_cast<char>(0x80 - 'A'));
+        const __m128i limit = _mm_set1_epi8(static_cast<char>(-128 + 26));
+        const __m128i bit   = _mm_set1_epi8(0x20);
+        for (; i + 16 <= n; i += 16) {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            // 'A'..'Z' maps to -128..-103 after the bias, the only range below limit
+            va = _mm_or_si128(va, _mm_and_si128(_mm_cmplt_epi8(_mm_add_epi8(va, bias), limit), bit));
+            vb = _mm_or_si128(vb, _mm_and_si128(_mm_cmplt_epi8(_mm_add_epi8(vb, bias), limit), bit));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)));
+            if (mask != 0xFFFF) return i + static_cast<std::size_t>(__builtin_ctz(~mask));
+        }
+#endif
+        for (; i + 8 <= n; i += 8) {
+            std::uint64_t x, y;
+            std::memcpy(&x, a + i, 8);
+            std::memcpy(&y, b + i, 8);
+            if (lower8(x) != lower8(y)) break;   // the byte loop below finds which one
+        }
+        for (; i < n; ++i) {
+            if (lowerByte(static_cast<unsigned char>(a[i])) != lowerByte(static_cast<unsigned char>(b[i]))) return i;
+        }
+        return n;
+    }
+
+public:
+    // <0, 0, >0 like strcmp, ignoring ASCII case
+    static int compare(std::string_view a, std::string_view b) {
+        std::size_t n = a.size() < b.size() ? a.size() : b.size();
+        std::size_t i = firstDifference(a.data(), b.data(), n);
+        if (i < n) {
+            return static_cast<int>(lowerByte(static_cast<unsigned char>(a[i]))) -
+                   static_cast<int>(lowerByte(static_cast<unsigned char>(b[i])));
+        }
+        return a.size() < b.size() ? -1 : (a.size() > b.size() ? 1 : 0);
+    }
+
+    static bool equal(std::string_view a, std::string_view b) {
+        return a.size() == b.size() && firstDifference(a.data(), b.data(), a.size()) == a.size();
+    }
+
+    // Lower cased copy, used to build sort keys once per element
+    static std::string lower(std::string_view str) {
+        std::string out(str);
+        std::size_t i = 0;
+        for (; i + 8 <= out.size(); i += 8) {
+            std::uint64_t x;
+            std::memcpy(&x, out.data() + i, 8);
+            x = lower8(x);
+            std::memcpy(out.data() + i, &x, 8);
+        }
+        for (; i < out.size(); ++i) out[i] = static_cast<char>(lowerByte(static_cast<unsigned char>(out[i])));
+        return out;
+    }
+
+    // Comparators for the Sorter/Search templates
+    struct Less {
+        bool operator()(std::string_view a, std::string_view b) const { return compare(a, b) < 0; }
+    };
+    struct Equal {
+        bool operator()(std::string_view a, std::string_view b) const { return equal(a, b); }
+    };
+};
@@ -0,0 +1,151 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>      // std::size_t
+#include <cstdint>
+#include <mutex>
+#include <utility>      // std::forward
+#include <vector>
+#include "binaryTree.h"
+// NOT USING NAMESPACE STD FOR MORE ROBUST CODE
+
+/*
+ConcurrentTree (templated)
+    Use: Share one tree between many threads that mostly read it. Readers never lock and
+         never wait on writers; writers take turns on a mutex.
+    Steps: A reader marks itself active with the current epoch → loads the current snapshot
+           → searches/walks it → marks itself done.
+           A writer copies the current snapshot → changes the copy → publishes it with one
+           atomic store → retires the old one with the epoch it was replaced in → frees
+           retired snapshots once no active reader can still be looking at them.
+    Notes:
+        - Snapshots are never changed after they are published, so readers need no locks and a
+          walk always sees one consistent tree (RCU style, epoch based reclamation).
+        - Reads are wait-free while fewer than 256 threads read at the same time (one epoch
+          slot each, a thread normally gets the same slot right away).
+        - A write copies the whole tree. With NodePool storage that is one memcpy of the node
+          array (12 bytes a node for binaryTree), about what one search of binaryTree costs.
+          Use update() to do a batch of changes for the price of one copy.
+        - Tree must be copyable, and a copy must not share nodes with the original. Default
+          is binaryTree (a copy of a tree on a shared NodePool gets its own pool), BalancedTree
+          works too.
+*/
+
+template <typename Tree = binaryTree>
+class ConcurrentTree {
+private:
+    static constexpr std::size_t slotCount = 256;
+
+    // One reader epoch per slot, each on its own cache line. 0 = nobody reading.
+    struct alignas(64) Slot {
+        std::atomic<std::uint64_t> epoch{0};
+    };
+
+    struct Retired {
+        Tree* tree;
+        std::uint64_t epoch;   // global epoch when it was replaced
+    };
+
+    std::atomic<Tree*> current;
+    std::atomic<std::uint64_t> epoch{1};
+    std::array<Slot, slotCount> slots;
+
+    std::mutex writeMtx;           // writers only
+    std::vector<Retired> retired;  // guarded by writeMtx
+
+    static std::size_t threadHint() {
+        static std::atomic<std::size_t> nextHint{0};
+        thread_local std::size_t hint = nextHint.fetch_add(1);
+        return hint;
+    }
+
+    // Marks the calling thread active for as long as it lives
+    class ReadGuard {
+        Slot* slot = nullptr;
+
+    public:
+        explicit ReadGuard(ConcurrentTree& ct) {
+            std::size_t start = threadHint();
+            for (std::size_t k = 0;; ++k) {
+                Slot& s = ct.slots[(start + k) % slotCount];
+                std::uint64_t free = 0;
+                if (s.epoch.compare_exchange_strong(free, ct.epoch.load())) {
+                    slot = &s;
+                    return;
+                }
+            }
+        }
+        ~ReadGuard() { slot->epoch.store(0, std::memory_order_release); }
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+    };
+
+    // Frees retired snapshots that every active reader started after. Called with writeMtx held.
+    void reclaim() {
+        std::uint64_t oldestActive = static_cast<std::uint64_t>(-1);
+        for (Slot& s : slots) {
+            std::uint64_t e = s.epoch.load();
+            if (e != 0 && e < oldestActive) oldestActive = e;
+        }
+        std::size_t kept = 0;
+        for (Retired& r : retired) {
+            // a reader that announced epoch > r.epoch loaded the pointer after r was replaced
+            if (r.epoch < oldestActive) delete r.tree;
+            else retired[kept++] = r;
+        }
+        retired.resize(kept);
+    }
+
+public:
+    ConcurrentTree() : current(new Tree()) {}
+    // Starts from a copy of initial. For a binaryTree on a shared NodePool that copy has its
+    // own pool, so the snapshots never share nodes (or a growing array) with other trees.
+    explicit ConcurrentTree(const Tree& initial) : current(new Tree(initial)) {}
+
+    ConcurrentTree(const ConcurrentTree&) = delete;
+    ConcurrentTree& operator=(const ConcurrentTree&) = delete;
+
+    // No reader or writer may still be running
+    ~ConcurrentTree() {
+        delete current.load();
+        for (Retired& r : retired) delete r.tree;
+    }
+
+    // Runs f(const Tree&) on the current snapshot without locking, returns what f returns.
+    // Don't keep references into the tree after f returns, the snapshot may be freed.
+    template <typename F>
+    decltype(auto) read(F&& f) {
+        ReadGuard guard(*this);
+        const Tree* snapshot = current.load();
+        return std::forward<F>(f)(*snapshot);
+    }
+
+    // Applies f(Tree&) to a private copy and publishes it. Writers run one at a time.
+    template <typename F>
+    void update(F&& f) {
+        std::lock_guard<std::mutex> lock(writeMtx);
+        Tree* old = current.load();
+        Tree* next = new Tree(*old);
+        std::forward<F>(f)(*next);
+        current.store(next);
+        retired.push_back({ old, epoch.fetch_add(1) });
+        reclaim();
+    }
+
+    // binaryTree calls, readers and writers as above
+    bool search(int value) { return read([value](const Tree& t) { return t.search(value); }); }
+
+    template <typename F>
+    bool visit(binaryTree::Order order, F&& f) {
+        return read([&](const Tree& t) { return t.visit(order, f); });
+    }
+
+    void insertNode(int value) { update([value](Tree& t) { t.insertNode(value); }); }
+    void deleteNode(int value) { update([value](Tree& t) { t.deleteNode(value); }); }
+
+    // Snapshots replaced but not freed yet (a reader may still be on them)
+    std::size_t retiredCount() {
+        std::lock_guard<std::mutex> lock(writeMtx);
+        return retired.size();
+    }
+};
@@ -0,0 +1,382 @@
+#pragma once
+#include <algorithm>    // std::max, std::copy
+#include <cstddef>      // std::size_t
+#include <cstdint>
+#include <cstdio>       // std::FILE, std::fopen, std::fwrite
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>      // std::move
+#include <vector>
+#include "fileLoader.h"
+#include "stringSplitter.h"
+#include "threadPool.h"
+// NOT USING NAMESPACE STD FOR MORE ROBUST CODE
+
+/*
+21. CSVTableLite
+    Use: Load CSV (exports, logs, datasets up to several GB) and read it by row/column without
+         a std::string per field.
+    Steps: One buffer holds the whole text → find delimiters, quotes and newlines 16 bytes at a
+           time (ByteScan) → every field becomes {offset, length} in its column's array →
+           at(row, col) hands back a std::string_view into the buffer.
+    Notes:
+        - Columnar: column c is one std::vector<CSVField> (16 bytes per field), so reading a
+          column walks one array. Rows with fewer fields get empty ones, a row with more adds
+          a column (earlier rows empty there).
+        - Quoted fields: at() returns what is between the quotes. A doubled quote inside ("")
+          stays doubled in the view; isEscaped(row, col) says so and text(row, col) returns the
+          unescaped copy. Blank lines are skipped, "\r\n" endings are fine.
+        - load(path) owns the text, parse(view) only points at the caller's text (keep it
+          alive). Both return false and set error() on an unterminated quote or a bad file.
+        - Parallel parse: count quotes per chunk on every thread → the quote parity at each
+          chunk start tells which newline after it is a real row end → each thread parses
+          rows from there to the next chunk's start → columns are glued together.
+          This assumes quotes only appear as field quoting (RFC 4180); a stray quote in the
+          middle of an unquoted field ("5" 2"") is fine serially but throws the parity off.
+        - save(path) writes the table back (header included), fields exactly as they were read.
+*/
+
+struct CSVField {
+    std::uint64_t offset = 0;   // into the text
+    std::uint32_t length = 0;
+    std::uint32_t flags = 0;    // quoted / escaped
+};
+
+struct CSVOptions {
+    char delimiter = ',';
+    char quote = '"';
+    bool header = true;   // first row is column names, not data
+};
+
+class CSVTableLite {
+public:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+    static constexpr std::uint32_t quoted = 1;
+    static constexpr std::uint32_t escaped = 2;   // has a doubled quote inside
+
+    // One column, indexed by data row
+    class Column {
+        const CSVTableLite* table;
+        std::size_t col;
+
+    public:
+        Column(const CSVTableLite* t, std::size_t c) : table(t), col(c) {}
+        std::string_view operator[](std::size_t row) const { return table->at(row, col); }
+        std::size_t size() const { return table->rows(); }
+
+        class iterator {
+            const Column* c;
+            std::size_t row;
+
+        public:
+            iterator(const Column* col, std::size_t r) : c(col), row(r) {}
+            std::string_view operator*() const { return (*c)[row]; }
+            iterator& operator++() { ++row; return *this; }
+            bool operator==(const iterator& o) const { return row == o.row; }
+        };
+        iterator begin() const { return { this, 0 }; }
+        iterator end() const { return { this, size() }; }
+    };
+
+private:
+    // Result of parsing one stretch of whole rows
+    struct Chunk {
+        std::vector<std::vector<CSVField>> columns;
+        std::size_t rows = 0;
+        std::size_t badQuoteAt = npos;
+    };
+
+    std::string owned;
+    std::string_view view;
+    bool ownsText = false;
+    CSVOptions opt;
+    std::vector<std::vector<CSVField>> columns;
+    std::size_t rowCount = 0;     // data rows, header not counted
+    std::size_t firstRow = 0;     // 1 when row 0 is the header
+    std::string err;
+
+    std::string_view source() const { return ownsText ? std::string_view(owned) : view; }
+
+    // Parses the rows in text[begin, end). Only delimiters, quotes and newlines are looked at,
+    // the mask of those comes 16 bytes at a time.
+    static Chunk parseRange(std::string_view text, std::size_t begin, std::size_t end, const CSVOptions& o) {
+        Chunk out;
+        const char* p = text.data();
+        // every column gets room for this many rows up front, so the arrays never regrow
+        std::size_t rowsGuess = ByteScan::count(p + begin, end - begin, '\n') + 1;
+        std::size_t fieldStart = begin, quoteEnd = 0, col = 0, skip = 0;
+        bool inQuotes = false;
+        std::uint32_t flags = 0;
+
+        auto endField = [&](std::size_t stop) {
+            CSVField f{ fieldStart, static_cast<std::uint32_t>((flags & quoted ? quoteEnd : stop) - fieldStart), flags };
+            if (col == out.columns.size()) {   // new column, empty so far
+                out.columns.emplace_back().reserve(rowsGuess);
+                out.columns.back().resize(out.rows);
+            }
+            out.columns[col++].push_back(f);
+            flags = 0;
+        };
+        auto endRow = [&] {
+            for (std::size_t c = col; c < out.columns.size(); ++c) out.columns[c].push_back({});
+            ++out.rows;
+            col = 0;
+        };
+        auto handle = [&](std::size_t i) {
+            if (i < skip) return;   // second quote of a ""
+            char c = p[i];
+            if (inQuotes) {
+                if (c != o.quote) return;
+                if (i + 1 < end && p[i + 1] == o.quote) {
+                    flags |= escaped;
+                    skip = i + 2;
+                }
+                else {
+                    inQuotes = false;
+                    quoteEnd = i;
+                }
+            }
+            else if (c == o.quote) {
+                if (i != fieldStart) return;   // stray quote inside a plain field, keep it as text
+                inQuotes = true;
+                flags = quoted;
+                fieldStart = i + 1;
+            }
+            else if (c == o.delimiter) {
+                endField(i);
+                fieldStart = i + 1;
+            }
+            else {   // '\n'
+                std::size_t stop = i > fieldStart && p[i - 1] == '\r' ? i - 1 : i;
+                if (col == 0 && stop == fieldStart && !(flags & quoted)) {   // blank line
+                    fieldStart = i + 1;
+                    return;
+                }
+                endField(stop);
+                endRow();
+                fieldStart = i + 1;
+            }
+        };
+
+        std::size_t i = begin;
+        for (; i + ByteScan::block <= end; i += ByteScan::block)
+            for (std::uint32_t m = ByteScan::match(p + i, o.delimiter, o.quote, '\n'); m; m &= m - 1)
+                handle(i + static_cast<std::size_t>(std::countr_zero(m)));
+        if (i < end)
+            for (std::uint32_t m = ByteScan::matchTail(p + i, end - i, o.delimiter, o.quote, '\n'); m; m &= m - 1)
+                handle(i + static_cast<std::size_t>(std::countr_zero(m)));
+
+        if (inQuotes) {
+            out.badQuoteAt = fieldStart - 1;
+            return out;
+        }
+        std::size_t stop = end > fieldStart && p[end - 1] == '\r' ? end - 1 : end;
+        if (col > 0 || stop > fieldStart || (flags & quoted)) {   // last row without a newline
+            endField(stop);
+            endRow();
+        }
+        return out;
+    }
+
+    // First position after a newline that ends a row, at or after from. inQuotes is the quote
+    // state at from (from the quote parity).
+    std::size_t rowStartAfter(std::size_t from, bool inQuotes) const {
+        std::string_view t = source();
+        std::size_t i = from;
+        while (true) {
+            i = ByteScan::find(t.data(), t.size(), i, opt.quote, '\n');
+            if (i == t.size()) return i;
+            if (t[i] == '\n' && !inQuotes) return i + 1;
+            if (t[i] == opt.quote) inQuotes = !inQuotes;
+            ++i;
+        }
+    }
+
+    bool finish(std::vector<Chunk>& chunks) {
+        for (const Chunk& c : chunks) {
+            if (c.badQuoteAt != npos) {
+                err = "unterminated quote starting at byte " + std::to_string(c.badQuoteAt);
+                columns.clear();
+                rowCount = 0;
+                return false;
+            }
+        }
+        if (chunks.size() == 1) {
+            columns = std::move(chunks[0].columns);
+            rowCount = chunks[0].rows;
+        }
+        else {
+            std::size_t cols = 0, rows = 0;
+            for (const Chunk& c : chunks) {
+                cols = std::max(cols, c.columns.size());
+                rows += c.rows;
+            }
+            columns.assign(cols, {});
+            for (std::size_t col = 0; col < cols; ++col) {
+                columns[col].reserve(rows);
+                for (Chunk& c : chunks) {
+                    if (col >= c.columns.size()) {
+                        columns[col].resize(columns[col].size() + c.rows);   // this chunk never had the column
+                        continue;
+                    }
+                    columns[col].insert(columns[col].end(), c.columns[col].begin(), c.columns[col].end());
+                    std::vector<CSVField>().swap(c.columns[col]);
+                }
+            }
+            rowCount = rows;
+        }
+        firstRow = opt.header && rowCount > 0 ? 1 : 0;
+        rowCount -= firstRow;
+        err.clear();
+        return true;
+    }
+
+    bool run(std::size_t parts, ThreadPool* pool) {
+        std::string_view t = source();
+        std::vector<Chunk> chunks;
+        if (parts <= 1 || t.size() < parts * 4096) {
+            chunks.push_back(parseRange(t, 0, t.size(), opt));
+            return finish(chunks);
+        }
+
+        // quote parity at every chunk start
+        std::vector<std::size_t> quotes(parts);
+        ThreadPool::TaskGroup count(*pool);
+        for (std::size_t k = 0; k < parts; ++k)
+            count.run([&, k] {
+                std::size_t lo = t.size() * k / parts, hi = t.size() * (k + 1) / parts;
+                quotes[k] = ByteScan::count(t.data() + lo, hi - lo, opt.quote);
+            });
+        count.wait();
+
+        std::vector<std::size_t> starts(parts + 1, t.size());
+        starts[0] = 0;
+        std::size_t parity = 0;
+        for (std::size_t k = 1; k < parts; ++k) {
+            parity += quotes[k - 1];
+            starts[k] = std::max(starts[k - 1], rowStartAfter(t.size() * k / parts, parity & 1));
+        }
+
+        chunks.resize(parts);
+        ThreadPool::TaskGroup parse(*pool);
+        for (std::size_t k = 0; k < parts; ++k)
+            parse.run([&, k] { chunks[k] = parseRange(t, starts[k], starts[k + 1], opt); });
+        parse.wait();
+        return finish(chunks);
+    }
+
+public:
+    CSVTableLite() = default;
+
+    // Points at text, which has to stay alive as long as the table is used
+    bool parse(std::string_view text, CSVOptions o = {}) {
+        view = text;
+        ownsText = false;
+        opt = o;
+        return run(1, nullptr);
+    }
+
+    bool parse(std::string_view text, CSVOptions o, ThreadPool& pool) {
+        view = text;
+        ownsText = false;
+        opt = o;
+        return run(pool.size() + 1, &pool);
+    }
+
+    // threads = 0 means one per hardware thread
+    bool parseParallel(std::string_view text, CSVOptions o = {}, std::size_t threads = 0) {
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        if (threads == 1) return parse(text, o);
+        ThreadPool pool(threads - 1);   // the calling thread is the last one
+        return parse(text, o, pool);
+    }
+
+    // Takes the text over, nothing else has to stay alive
+    bool parseOwned(std::string text, CSVOptions o = {}, std::size_t threads = 1) {
+        owned = std::move(text);
+        ownsText = true;
+        opt = o;
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        if (threads == 1) return run(1, nullptr);
+        ThreadPool pool(threads - 1);
+        return run(threads, &pool);
+    }
+
+    bool load(const std::string& path, CSVOptions o = {}, std::size_t threads = 1) {
+        std::string text;
+        if (!FileLoader::readAll(path, text)) {
+            err = "cannot read " + path;
+            return false;
+        }
+        return parseOwned(std::move(text), o, threads);
+    }
+
+    // Writes the header row (if any) and every row, fields exactly as read
+    bool save(const std::string& path) const {
+        std::FILE* f = std::fopen(path.c_str(), "wb");
+        if (!f) return false;
+        std::string_view t = source();
+        std::string line;
+        bool ok = true;
+        for (std::size_t r = 0; r < rowCount + firstRow && ok; ++r) {
+            line.clear();
+            for (std::size_t c = 0; c < columns.size(); ++c) {
+                const CSVField& fl = columns[c][r];
+                if (c) line += opt.delimiter;
+                if (fl.flags & quoted) line += opt.quote;
+                line.append(t.substr(fl.offset, fl.length));
+                if (fl.flags & quoted) line += opt.quote;
+            }
+            line += '\n';
+            ok = std::fwrite(line.data(), 1, line.size(), f) == line.size();
+        }
+        return std::fclose(f) == 0 && ok;
+    }
+
+    std::size_t rows() const { return rowCount; }
+    std::size_t cols() const { return columns.size(); }
+
+    // Field text without its quotes, "" for a field the row didn't have
+    std::string_view at(std::size_t row, std::size_t col) const {
+        const CSVField& f = columns[col][row + firstRow];
+        return source().substr(f.offset, f.length);
+    }
+    bool isEscaped(std::size_t row, std::size_t col) const { return columns[col][row + firstRow].flags & escaped; }
+
+    // Copy with "" turned back into "
+    std::string text(std::size_t row, std::size_t col) const {
+        std::string_view v = at(row, col);
+        if (!isEscaped(row, col)) return std::string(v);
+        std::string s;
+        s.reserve(v.size());
+        for (std::size_t i = 0; i < v.size(); ++i) {
+            s += v[i];
+            if (v[i] == opt.quote) ++i;
+        }
+        return s;
+    }
+
+    // Header name of col ("" without a header)
+    std::string_view name(std::size_t col) const {
+        if (!firstRow) return {};
+        const CSVField& f = columns[col][0];
+        return source().substr(f.offset, f.length);
+    }
+    // Column with that header name, or npos
+    std::size_t columnIndex(std::string_view header) const {
+        for (std::size_t c = 0; c < columns.size(); ++c)
+            if (name(c) == header) return c;
+        return npos;
+    }
+    Column column(std::size_t col) const { return { this, col }; }
+    // Raw field array of a column (header field first if there is one)
+    const std::vector<CSVField>& fields(std::size_t col) const { return columns[col]; }
+
+    const std::string& error() const { return err; }
+    std::size_t bytes() const {
+        std::size_t b = owned.capacity();
+        for (const auto& c : columns) b += c.capacity() * sizeof(CSVField);
+        return b;
+    }
+};
@@ -0,0 +1,272 @@
+#pragma once
+#include <algorithm>    // std::is_sorted, std::max
+#include <concepts>     // std::totally_ordered
+#include <cstddef>      // std::size_t
+#include <cstdint>
+#include <functional>   // std::hash, std::equal_to
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>      // std::move
+#include <vector>
+#include "flatHashSet.h"
+#include "sorter.h"
+#include "threadPool.h"
+// NOT USING NAMESPACE STD FOR MORE ROBUST CODE
+
+/*
+Deduper (Uniq + Deduper, templated)
+    Use: Remove duplicates from an array, std::array or vector, sorted or not.
+    Steps: Sorted input: one sweep that keeps each value the first time it shows up.
+           Unsorted input: walk the data once, keep a value only if a FlatHashSet hasn't seen
+           it yet, and move the kept ones down to the front.
+           Either way the unique values end up at the front in first-seen order and a
+           vector is shrunk to them; arrays keep their length and the result says how many
+           are unique (like std::unique, the rest is left moved-from).
+    Notes:
+        - The set holds 4 byte positions into the data, not copies of the values, so deduping
+          strings copies no strings and allocates only the set's two arrays.
+        - dedupe() checks whether the data is already sorted (stops at the first descent, so
+          it costs nothing on unsorted data) and takes the sweep when it is.
+        - DedupeOrder::any lets dedupe switch numbers to radix sort + sweep once more than ~1M
+          values turned out unique: past that the set no longer fits in cache and every
+          insert is a cache miss, while the radix sort streams. Output is then sorted.
+        - parallel_dedupe splits the values by hash into one partition per thread, so every
+          thread owns a set and no locks are needed. Keeps first-seen order.
+        - Hash / Eq are the std::hash / == style pair, same as std::unordered_set takes.
+*/
+
+// Result of a dedupe: data[0, size) are the unique values
+struct DedupeResult {
+    std::size_t size = 0;            // unique values kept
+    std::size_t removed = 0;         // duplicates dropped
+    bool firstSeenOrder = false;     // kept values are in the order they first appeared
+    const char* engine = "";         // "sweep", "hash", "sort-sweep", "parallel-hash"
+};
+
+enum class DedupeOrder { firstSeen, any };
+
+class Deduper {
+private:
+    struct StdHash {
+        template <typename K>
+        std::size_t operator()(const K& k) const { return std::hash<K>{}(k); }
+    };
+
+    // Hash / compare positions by the values at those positions
+    template <typename Elem, typename Hash, typename Index>
+    struct PosHash {
+        const Elem* data;
+        Hash hash;
+        std::size_t operator()(Index i) const { return hash(data[i]); }
+    };
+    template <typename Elem, typename Eq, typename Index>
+    struct PosEq {
+        const Elem* data;
+        Eq eq;
+        bool operator()(Index a, Index b) const { return eq(data[a], data[b]); }
+    };
+
+    // Keeps the first of every run of equal neighbours
+    template <typename Elem, typename Eq>
+    static std::size_t sweep(std::span<Elem> s, Eq& eq) {
+        if (s.empty()) return 0;
+        std::size_t kept = 1;
+        for (std::size_t i = 1; i < s.size(); ++i) {
+            if (eq(s[kept - 1], s[i])) continue;
+            if (kept != i) s[kept] = std::move(s[i]);
+            ++kept;
+        }
+        return kept;
+    }
+
+    // Every value is moved to the next free spot first and then offered to the set as that
+    // position. Everything in [kept, i) is already a dropped duplicate, so the move never
+    // overwrites anything kept, and a value that turns out to be a repeat is just overwritten
+    // by the next one.
+    template <typename Index, typename Elem, typename Hash, typename Eq>
+    static std::size_t hashCompact(std::span<Elem> s, Hash& hash, Eq& eq) {
+        using Set = FlatHashSet<Index, PosHash<Elem, Hash, Index>, PosEq<Elem, Eq, Index>>;
+        Set seen({ s.data(), hash }, { s.data(), eq });
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < s.size(); ++i) {
+            if (kept != i) s[kept] = std::move(s[i]);
+            if (seen.insert(static_cast<Index>(kept))) ++kept;
+        }
+        return kept;
+    }
+
+    // Numbers: the set holds the values themselves, which saves the trip back to the data
+    // on every tag match (one cache miss instead of two on big inputs). Stops early once
+    // maxUnique values are kept; stoppedAt is where it got to.
+    template <typename Elem, typename Hash, typename Eq>
+    static std::size_t valueCompact(std::span<Elem> s, Hash& hash, Eq& eq, std::size_t maxUnique, std::size_t& stoppedAt) {
+        FlatHashSet<Elem, Hash, Eq> seen(hash, eq);
+        std::size_t kept = 0, i = 0;
+        for (; i < s.size() && kept < maxUnique; ++i) {
+            if (seen.insert(s[i])) s[kept++] = s[i];
+        }
+        stoppedAt = i;
+        return kept;
+    }
+
+    template <typename Elem, typename Hash, typename Eq>
+    static std::size_t hashDedupe(std::span<Elem> s, Hash& hash, Eq& eq) {
+        if constexpr (std::is_arithmetic_v<Elem>) {
+            std::size_t stoppedAt = 0;
+            return valueCompact(s, hash, eq, s.size(), stoppedAt);
+        }
+        if (s.size() <= UINT32_MAX) return hashCompact<std::uint32_t>(s, hash, eq);
+        return hashCompact<std::uint64_t>(s, hash, eq);
+    }
+
+    // One partition per thread: each chunk of the input is split by hash, then every
+    // partition runs through its own set in input order and marks the first of each value
+    template <typename Index, typename Elem, typename Hash, typename Eq>
+    static std::size_t parallelCompact(std::span<Elem> s, Hash& hash, Eq& eq, ThreadPool& pool) {
+        using PosSet = FlatHashSet<Index, PosHash<Elem, Hash, Index>, PosEq<Elem, Eq, Index>>;
+        struct Entry {
+            Index pos;
+            std::size_t hash;
+        };
+        std::size_t n = s.size();
+        std::size_t parts = pool.size() + 1;
+        std::vector<std::vector<Entry>> buckets(parts * parts);   // [chunk * parts + partition]
+        std::vector<unsigned char> keep(n, 0);
+
+        ThreadPool::TaskGroup split(pool);
+        for (std::size_t c = 0; c < parts; ++c) {
+            split.run([&, c] {
+                std::size_t lo = n * c / parts, hi = n * (c + 1) / parts;
+                for (std::size_t p = 0; p < parts; ++p) buckets[c * parts + p].reserve((hi - lo) / parts + 16);
+                for (std::size_t i = lo; i < hi; ++i) {
+                    std::size_t h = hash(s[i]);
+                    // top bits pick the partition, the set uses the low ones
+                    std::size_t p = static_cast<std::size_t>(((FlatHashSet<Index>::mix(h) >> 32) * parts) >> 32);
+                    buckets[c * parts + p].push_back({ static_cast<Index>(i), h });
+                }
+            });
+        }
+        split.wait();
+
+        ThreadPool::TaskGroup mark(pool);
+        for (std::size_t p = 0; p < parts; ++p) {
+            mark.run([&, p] {
+                // numbers go in the set by value, like valueCompact
+                auto seen = [&] {
+                    if constexpr (std::is_arithmetic_v<Elem>) return FlatHashSet<Elem, Hash, Eq>(hash, eq);
+                    else return PosSet({ s.data(), hash }, { s.data(), eq });
+                }();
+                for (std::size_t c = 0; c < parts; ++c) {
+                    for (const Entry& e : buckets[c * parts + p]) {
+                        bool added;
+                        if constexpr (std::is_arithmetic_v<Elem>) added = seen.insertHashed(s[e.pos], e.hash);
+                        else added = seen.insertHashed(e.pos, e.hash);
+                        if (added) keep[e.pos] = 1;
+                    }
+                    std::vector<Entry>().swap(buckets[c * parts + p]);
+                }
+            });
+        }
+        mark.wait();
+
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (!keep[i]) continue;
+            if (kept != i) s[kept] = std::move(s[i]);
+            ++kept;
+        }
+        return kept;
+    }
+
+    // Numbers that Sorter radix sorts, compared with plain ==
+    template <typename Elem, typename Hash, typename Eq>
+    static constexpr bool radixFriendly = std::is_arithmetic_v<Elem> && !std::is_same_v<Elem, bool> &&
+        std::is_same_v<Hash, StdHash> && (std::is_same_v<Eq, std::equal_to<>> || std::is_same_v<Eq, std::equal_to<Elem>>);
+
+    // DedupeOrder::any on numbers hashes until this many values are unique (the set is then
+    // ~18MB, past most caches), then radix sorts what is left and sweeps
+    static constexpr std::size_t hashLimit = 1 << 20;
+
+    // A sorted check needs < and must agree with Eq, so only for the default ==
+    template <typename Elem, typename Eq>
+    static bool alreadySorted(std::span<Elem> s) {
+        if constexpr (std::totally_ordered<Elem> && (std::is_same_v<Eq, std::equal_to<>> || std::is_same_v<Eq, std::equal_to<Elem>>)) {
+            return std::is_sorted(s.begin(), s.end());
+        }
+        else return false;
+    }
+
+    // Vectors lose the tail, fixed size arrays keep it
+    template <typename T>
+    static void shrink(T& arr, std::size_t size) {
+        if constexpr (requires { arr.erase(arr.begin(), arr.end()); }) {
+            arr.erase(arr.begin() + static_cast<std::ptrdiff_t>(size), arr.end());
+        }
+    }
+
+    template <typename T>
+    static DedupeResult finish(T& arr, std::size_t before, std::size_t size, bool firstSeen, const char* engine) {
+        shrink(arr, size);
+        return { size, before - size, firstSeen, engine };
+    }
+
+public:
+    // Sorted data (or any data where repeats are next to each other, like Unix uniq):
+    // one pass, keeps the first of every run
+    template <typename T, typename Eq = std::equal_to<>>
+    DedupeResult uniq(T& arr, Eq eq = {}) {
+        auto s = std::span(arr);
+        using Elem = typename decltype(s)::element_type;
+        std::size_t n = s.size();
+        return finish(arr, n, sweep(std::span<Elem>(s), eq), true, "sweep");
+    }
+
+    // Any data. Keeps the first copy of every value, in the order they first appeared.
+    // DedupeOrder::any also allows the kept values to come out sorted, if that is faster.
+    template <typename T, typename Hash = StdHash, typename Eq = std::equal_to<>>
+    DedupeResult dedupe(T& arr, DedupeOrder order = DedupeOrder::firstSeen, Hash hash = {}, Eq eq = {}) {
+        auto s = std::span(arr);
+        using Elem = typename decltype(s)::element_type;
+        std::span<Elem> all(s);
+        std::size_t n = all.size();
+
+        if (n < 2 || alreadySorted<Elem, Eq>(all)) return finish(arr, n, sweep(all, eq), true, "sweep");
+        if constexpr (radixFriendly<Elem, Hash, Eq>) {
+            if (order == DedupeOrder::any) {
+                std::size_t stoppedAt = 0;
+                std::size_t kept = valueCompact(all, hash, eq, hashLimit, stoppedAt);
+                if (stoppedAt == n) return finish(arr, n, kept, true, "hash");
+                // unique so far + everything not looked at yet, sorted and swept together
+                std::size_t rest = static_cast<std::size_t>(std::move(all.begin() + stoppedAt, all.end(), all.begin() + kept) - all.begin());
+                std::span<Elem> left = all.first(rest);
+                Sorter().introsort(left);
+                return finish(arr, n, sweep(left, eq), false, "sort-sweep");
+            }
+        }
+        return finish(arr, n, hashDedupe(all, hash, eq), true, "hash");
+    }
+
+    // Same as dedupe (first-seen order), with the hashing split across a ThreadPool
+    template <typename T, typename Hash = StdHash, typename Eq = std::equal_to<>>
+    DedupeResult parallel_dedupe(T& arr, ThreadPool& pool, Hash hash = {}, Eq eq = {}) {
+        auto s = std::span(arr);
+        using Elem = typename decltype(s)::element_type;
+        std::span<Elem> all(s);
+        std::size_t n = all.size();
+
+        if (n < 2 || alreadySorted<Elem, Eq>(all)) return finish(arr, n, sweep(all, eq), true, "sweep");
+        std::size_t kept = n <= UINT32_MAX ? parallelCompact<std::uint32_t>(all, hash, eq, pool)
+                                           : parallelCompact<std::uint64_t>(all, hash, eq, pool);
+        return finish(arr, n, kept, true, "parallel-hash");
+    }
+
+    // threads = 0 means one per hardware thread
+    template <typename T, typename Hash = StdHash, typename Eq = std::equal_to<>>
+    DedupeResult parallel_dedupe(T& arr, std::size_t threads, Hash hash = {}, Eq eq = {}) {
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        if (threads == 1) return dedupe(arr, DedupeOrder::firstSeen, hash, eq);
+        ThreadPool pool(threads - 1);   // the calling thread is the last one
+        return parallel_dedupe(arr, pool, hash, eq);
+    }
+};
@@ -0,0 +1,516 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>      // std::size_t
+#include <cstdint>
+#include <cstdio>       // std::FILE, std::fopen, std::fread, std::fwrite
+#include <cstring>      // std::memcpy
+#include <filesystem>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>      // std::exchange, std::move
+#include <vector>
+#include "stringSplitter.h"
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define FILELOADER_POSIX 1
+#endif
+// NOT USING NAMESPACE STD FOR MORE ROBUST CODE
+
+/*
+19. FileLoader
+    Use: Read whole files, read huge files (bigger than RAM) line by line, write files so a
+         crash never leaves half of one behind.
+    Steps: MappedFile::open() maps the file (pages load when first touched) → text() / bytes()
+           view it → close() unmaps. Or ChunkReader / LineReader stream it through two fixed
+           buffers, or FileWriter collects output and renames path.tmp over path at the end.
+    Notes:
+        - MappedFile: open costs the same for 1 KB or 100 GB. Access::sequential / willNeed
+          become madvise hints (read ahead aggressively, drop pages behind), release(offset, n)
+          tells the kernel a processed range can go. Without POSIX mmap the file is read
+          into memory instead (same interface).
+        - ChunkReader: a background thread fills one buffer while the caller works on the
+          other (double buffering), so disk and CPU overlap. next(chunk) hands out a
+          string_view that stays valid until the following next().
+        - LineReader: string_view per line ("\n" or "\r\n"), no allocation per line. Only a
+          line that straddles two chunks is copied, into one reused buffer. Works with
+          range-for.
+        - FileWriter: writes go to a big buffer and out in one fwrite when it fills, to
+          path.tmp; commit() flushes, optionally fsyncs, then renames over path. No commit
+          (or abort()) removes the temp file and leaves path alone.
+        - FileLoader::readAll / writeAll / forEachLine are the one-call versions.
+        - Errors: functions return false, error() says why (const char*, no exceptions).
+*/
+
+enum class Access { normal, sequential, random, willNeed };
+
+// Read only view of a whole file
+class MappedFile {
+private:
+    const char* base = nullptr;
+    std::size_t fileSize = 0;
+    std::string buffer;   // file contents when there is no mmap
+    bool mapped = false;
+    const char* lastError = nullptr;
+
+    bool fail(const char* why) {
+        close();
+        lastError = why;
+        return false;
+    }
+
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& path, Access a = Access::normal) { open(path, a); }
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& o) noexcept { *this = std::move(o); }
+    MappedFile& operator=(MappedFile&& o) noexcept {
+        if (this != &o) {
+            close();
+            buffer = std::move(o.buffer);
+            mapped = std::exchange(o.mapped, false);
+            const char* from = std::exchange(o.base, nullptr);
+            base = mapped || !from ? from : buffer.data();   // a read-in copy moved with the string
+            fileSize = std::exchange(o.fileSize, 0);
+            lastError = o.lastError;
+        }
+        return *this;
+    }
+
+    bool open(const std::string& path, Access a = Access::normal) {
+        close();
+        lastError = nullptr;
+#ifdef FILELOADER_POSIX
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return fail("can't open file");
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            return fail("can't stat file");
+        }
+        fileSize = static_cast<std::size_t>(st.st_size);
+        if (fileSize == 0) {   // mmap can't map nothing, an empty view is fine
+            ::close(fd);
+            base = "";
+            return true;
+        }
+        void* p = ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);   // the mapping keeps the file open
+        if (p == MAP_FAILED) return fail("mmap failed");
+        base = static_cast<const char*>(p);
+        mapped = true;
+        advise(a);
+        return true;
+#else
+        (void)a;
+        std::FILE* f = std::fopen(path.c_str(), "rb");
+        if (!f) return fail("can't open file");
+        std::error_code ec;
+        fileSize = static_cast<std::size_t>(std::filesystem::file_size(path, ec));
+        if (ec) {
+            std::fclose(f);
+            return fail("can't stat file");
+        }
+        buffer.resize(fileSize);
+        bool ok = std::fread(buffer.data(), 1, fileSize, f) == fileSize;
+        std::fclose(f);
+        if (!ok) return fail("can't read file");
+        base = buffer.data();
+        return true;
+#endif
+    }
+
+    // Hint for the whole file or [offset, offset + n). Does nothing without mmap.
+    void advise(Access a, std::size_t offset = 0, std::size_t n = static_cast<std::size_t>(-1)) const {
+#ifdef FILELOADER_POSIX
+        if (!mapped || offset >= fileSize) return;
+        int how = a == Access::sequential ? MADV_SEQUENTIAL : a == Access::random ? MADV_RANDOM : a == Access::willNeed ? MADV_WILLNEED : MADV_NORMAL;
+        std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        std::size_t start = offset / page * page;   // madvise wants a page aligned start
+        std::size_t end = n > fileSize - offset ? fileSize : offset + n;
+        ::madvise(const_cast<char*>(base) + start, end - start, how);
+#else
+        (void)a, (void)offset, (void)n;
+#endif
+    }
+
+    // [offset, offset + n) is done with: its pages can be dropped now instead of pushing
+    // out something else. Only whole pages inside the range are released.
+    void release(std::size_t offset, std::size_t n) const {
+#ifdef FILELOADER_POSIX
+        if (!mapped || offset >= fileSize) return;
+        std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        std::size_t start = (offset + page - 1) / page * page;
+        std::size_t end = (n > fileSize - offset ? fileSize : offset + n) / page * page;
+        if (end > start) ::madvise(const_cast<char*>(base) + start, end - start, MADV_DONTNEED);
+#else
+        (void)offset, (void)n;
+#endif
+    }
+
+    void close() {
+#ifdef FILELOADER_POSIX
+        if (mapped) ::munmap(const_cast<char*>(base), fileSize);
+#endif
+        base = nullptr;
+        fileSize = 0;
+        buffer.clear();
+        mapped = false;
+    }
+
+    bool isOpen() const { return base != nullptr; }
+    bool isMapped() const { return mapped; }
+    const char* error() const { return lastError; }
+    std::size_t size() const { return fileSize; }
+    std::string_view text() const { return { base ? base : "", fileSize }; }
+    std::span<const unsigned char> bytes() const { return { reinterpret_cast<const unsigned char*>(base), fileSize }; }
+};
+
+// Streams a file in fixed size chunks, reading the next one on a background thread
+class ChunkReader {
+private:
+    struct Buffer {
+        std::vector<char> data;
+        std::size_t size = 0;
+        bool full = false;   // filled by the reader, not handed back by the caller yet
+    };
+
+    std::FILE* file = nullptr;
+    Buffer buffers[2];
+    std::size_t current = 1;        // buffer the caller holds
+    bool holding = false;
+    bool readAhead = true;
+    bool done = false;              // reader hit end of file or an error
+    bool stopping = false;
+    std::uint64_t offset = 0;       // file offset of the chunk the caller holds
+    std::uint64_t nextOffset = 0;
+    std::atomic<const char*> lastError{ nullptr };   // set by the reader thread, read by error()
+    std::mutex lock;
+    std::condition_variable changed;
+    std::thread reader;
+
+    // Fills b from the file, false at end of file
+    bool fill(Buffer& b) {
+        b.size = std::fread(b.data.data(), 1, b.data.size(), file);
+        if (b.size < b.data.size() && std::ferror(file)) lastError = "read failed";
+        return b.size > 0;
+    }
+
+    void readLoop() {
+        for (std::size_t k = 0;; k ^= 1) {
+            Buffer& b = buffers[k];
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                changed.wait(guard, [&] { return !b.full || stopping; });
+                if (stopping) return;
+            }
+            bool got = fill(b);   // no lock held while reading
+            std::lock_guard<std::mutex> guard(lock);
+            b.full = got;
+            if (!got) {
+                done = true;
+                changed.notify_all();
+                return;
+            }
+            changed.notify_all();
+        }
+    }
+
+public:
+    ChunkReader() = default;
+    ChunkReader(const std::string& path, std::size_t chunkBytes = std::size_t(1) << 20, bool background = true) {
+        open(path, chunkBytes, background);
+    }
+    ~ChunkReader() { close(); }
+    ChunkReader(const ChunkReader&) = delete;
+    ChunkReader& operator=(const ChunkReader&) = delete;
+
+    // background = false reads each chunk inside next() instead (one buffer, no thread)
+    bool open(const std::string& path, std::size_t chunkBytes = std::size_t(1) << 20, bool background = true) {
+        close();
+        lastError = nullptr;
+        file = std::fopen(path.c_str(), "rb");
+        if (!file) {
+            lastError = "can't open file";
+            return false;
+        }
+        std::setvbuf(file, nullptr, _IONBF, 0);   // fread goes straight into our buffers
+#ifdef FILELOADER_POSIX
+#ifdef POSIX_FADV_SEQUENTIAL
+        ::posix_fadvise(::fileno(file), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+#endif
+        if (chunkBytes < 4096) chunkBytes = 4096;
+        readAhead = background;
+        for (Buffer& b : buffers) {
+            b.data.resize(chunkBytes);
+            b.full = false;
+        }
+        current = 1;
+        holding = false;
+        done = stopping = false;
+        offset = nextOffset = 0;
+        if (readAhead) reader = std::thread([this] { readLoop(); });
+        return true;
+    }
+
+    // Next chunk of the file, valid until the next call. false at the end (or on an error).
+    bool next(std::string_view& chunk) {
+        if (!file) return false;
+        if (!readAhead) {
+            if (!fill(buffers[0])) return false;
+            offset = nextOffset;
+            nextOffset += buffers[0].size;
+            chunk = { buffers[0].data.data(), buffers[0].size };
+            return true;
+        }
+        std::unique_lock<std::mutex> guard(lock);
+        if (holding) {   // hand the last chunk back so the reader can refill it
+            buffers[current].full = false;
+            changed.notify_all();
+        }
+        current ^= 1;
+        Buffer& b = buffers[current];
+        changed.wait(guard, [&] { return b.full || done; });
+        holding = b.full;
+        if (!b.full) return false;
+        offset = nextOffset;
+        nextOffset += b.size;
+        chunk = { b.data.data(), b.size };
+        return true;
+    }
+
+    // Where the last chunk from next() starts in the file
+    std::uint64_t chunkOffset() const { return offset; }
+    const char* error() const { return lastError.load(); }
+    bool isOpen() const { return file != nullptr; }
+
+    void close() {
+        if (reader.joinable()) {
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                stopping = true;
+            }
+            changed.notify_all();
+            reader.join();
+        }
+        if (file) std::fclose(file);
+        file = nullptr;
+    }
+};
+
+// Lines of a file as string_views, streamed through a ChunkReader
+class LineReader {
+private:
+    ChunkReader chunks;
+    std::string_view chunk;     // unread rest of the current chunk
+    std::string carry;          // a line that started in an earlier chunk
+    bool ended = false;
+
+    static std::string_view stripCr(std::string_view l) {
+        return !l.empty() && l.back() == '\r' ? l.substr(0, l.size() - 1) : l;
+    }
+
+public:
+    LineReader() = default;
+    explicit LineReader(const std::string& path, std::size_t chunkBytes = std::size_t(1) << 20, bool background = true) {
+        open(path, chunkBytes, background);
+    }
+
+    bool open(const std::string& path, std::size_t chunkBytes = std::size_t(1) << 20, bool background = true) {
+        chunk = {};
+        carry.clear();
+        ended = false;
+        return chunks.open(path, chunkBytes, background);
+    }
+
+    // Next line without its "\n" / "\r\n", valid until the next call. false at the end.
+    bool next(std::string_view& line) {
+        if (ended) return false;
+        carry.clear();
+        while (true) {
+            std::size_t nl = ByteScan::find(chunk.data(), chunk.size(), 0, '\n');
+            if (nl < chunk.size()) {
+                std::string_view piece = chunk.substr(0, nl);
+                chunk.remove_prefix(nl + 1);
+                if (carry.empty()) line = stripCr(piece);
+                else {
+                    carry.append(piece);
+                    line = stripCr(carry);
+                }
+                return true;
+            }
+            carry.append(chunk);   // no newline left here, the line goes on in the next chunk
+            if (!chunks.next(chunk)) {
+                chunk = {};
+                ended = true;
+                if (carry.empty()) return false;   // file ended with a newline
+                line = stripCr(carry);
+                return true;
+            }
+        }
+    }
+
+    template <typename F>
+    void forEach(F&& f) {
+        std::string_view line;
+        while (next(line)) f(line);
+    }
+
+    const char* error() const { return chunks.error(); }
+
+    class iterator {
+        LineReader* r = nullptr;
+        std::string_view line;
+
+    public:
+        iterator() = default;
+        explicit iterator(LineReader* reader) : r(reader) { ++*this; }
+        std::string_view operator*() const { return line; }
+        iterator& operator++() {
+            if (r && !r->next(line)) r = nullptr;
+            return *this;
+        }
+        bool operator==(const iterator& o) const { return r == o.r; }
+    };
+    iterator begin() { return iterator(this); }
+    iterator end() { return {}; }
+};
+
+// Buffered writes to path.tmp, renamed over path on commit()
+class FileWriter {
+private:
+    std::FILE* file = nullptr;
+    std::string target;
+    std::string tmp;
+    std::vector<char> buffer;
+    std::size_t used = 0;
+    bool failed = false;
+    const char* lastError = nullptr;
+
+    bool flushBuffer() {
+        if (used && !failed && std::fwrite(buffer.data(), 1, used, file) != used) {
+            failed = true;
+            lastError = "write failed";
+        }
+        used = 0;
+        return !failed;
+    }
+
+public:
+    FileWriter() = default;
+    explicit FileWriter(const std::string& path, std::size_t bufferBytes = std::size_t(1) << 20) { open(path, bufferBytes); }
+    ~FileWriter() { abort(); }
+    FileWriter(const FileWriter&) = delete;
+    FileWriter& operator=(const FileWriter&) = delete;
+
+    bool open(const std::string& path, std::size_t bufferBytes = std::size_t(1) << 20) {
+        abort();
+        target = path;
+        tmp = path + ".tmp";
+        failed = false;
+        lastError = nullptr;
+        file = std::fopen(tmp.c_str(), "wb");
+        if (!file) {
+            lastError = "can't create temp file";
+            return false;
+        }
+        std::setvbuf(file, nullptr, _IONBF, 0);   // our buffer is the only one
+        buffer.resize(bufferBytes < 4096 ? 4096 : bufferBytes);
+        used = 0;
+        return true;
+    }
+
+    // Buffered; big writes go straight through. false once anything has failed.
+    bool write(std::string_view s) {
+        if (!file || failed) return false;
+        if (s.size() > buffer.size() - used) {
+            if (!flushBuffer()) return false;
+            if (s.size() >= buffer.size()) {
+                if (std::fwrite(s.data(), 1, s.size(), file) != s.size()) {
+                    failed = true;
+                    lastError = "write failed";
+                }
+                return !failed;
+            }
+        }
+        std::memcpy(buffer.data() + used, s.data(), s.size());
+        used += s.size();
+        return true;
+    }
+    bool writeLine(std::string_view s) { return write(s) && write("\n"); }
+
+    // Flushes, closes and renames path.tmp over path. durable = fsync first, so the new
+    // contents survive a power cut (slower). On failure path is untouched.
+    bool commit(bool durable = false) {
+        if (!file) return false;
+        bool ok = flushBuffer() && std::fflush(file) == 0;
+#ifdef FILELOADER_POSIX
+        if (ok && durable) ok = ::fsync(::fileno(file)) == 0;
+#else
+        (void)durable;
+#endif
+        ok = std::fclose(file) == 0 && ok;
+        file = nullptr;
+        std::error_code ec;
+        if (ok) std::filesystem::rename(tmp, target, ec);
+        if (!ok || ec) {
+            if (!lastError) lastError = ok ? "rename failed" : "write failed";
+            std::filesystem::remove(tmp, ec);
+            return false;
+        }
+        return true;
+    }
+
+    // Drops everything written, path stays as it was
+    void abort() {
+        if (!file) return;
+        std::fclose(file);
+        file = nullptr;
+        std::error_code ec;
+        std::filesystem::remove(tmp, ec);
+    }
+
+    bool isOpen() const { return file != nullptr; }
+    const char* error() const { return lastError; }
+};
+
+class FileLoader {
+public:
+    // Whole file into out
+    static bool readAll(const std::string& path, std::string& out) {
+        std::FILE* f = std::fopen(path.c_str(), "rb");
+        if (!f) return false;
+        std::error_code ec;
+        std::uintmax_t size = std::filesystem::file_size(path, ec);
+        out.resize(ec ? 0 : static_cast<std::size_t>(size));
+        bool ok = !ec && std::fread(out.data(), 1, out.size(), f) == out.size();
+        std::fclose(f);
+        return ok;
+    }
+
+    // Replaces path with text, never leaving a half written file
+    static bool writeAll(const std::string& path, std::string_view text, bool durable = false) {
+        FileWriter w(path, 4096);   // one write, anything bigger than the buffer goes straight to the file
+        return w.write(text) && w.commit(durable);
+    }
+
+    // f(line) for every line, through a sequential mapping (no copy at all)
+    template <typename F>
+    static bool forEachLine(const std::string& path, F&& f) {
+        MappedFile m(path, Access::sequential);
+        if (!m.isOpen()) return false;
+        StringSplitter::forEachLine(m.text(), f);
+        return true;
+    }
+};
@@ -0,0 +1,245 @@
+#pragma once
+#include <bit>          // std::countr_zero, std::bit_ceil
+#include <cstddef>      // std::size_t
+#include <cstdint>
+#include <cstring>      // std::memcpy
+#include <functional>   // std::hash, std::equal_to
+#include <iterator>
+#include <utility>      // std::move, std::swap
+#include <vector>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+// NOT USING NAMESPACE STD FOR MORE ROBUST CODE
+
+/*
+FlatHashSet (templated)
+    Use: Hash set for lots of small keys (ids, indices) where std::unordered_set spends
+         most of its time allocating and chasing node pointers.
+    Steps: Hash the key → low 7 bits are a tag, the rest picks a group of 16 slots →
+           compare the tag against all 16 control bytes of the group at once (SSE2) →
+           only check keys whose tag matched → stop at the first group with an empty slot.
+    Notes:
+        - Open addressing, SwissTable style: one control byte per slot (empty, deleted, or the
+          7 bit tag) plus the keys in a plain array. No allocation per insert, and a miss
+          usually costs one 16 byte compare instead of a key compare.
+        - Hash and Eq can hold state, e.g. hash/compare positions by the values they point at
+          (that's how Deduper stores 4 byte positions instead of copies of the keys).
+        - The hash is mixed before use, so identity hashes (std::hash<int>) are fine.
+        - Keys must be default constructible (the slot array is a std::vector<Key>).
+        - Grows at 7/8 full. insert/erase invalidate iterators.
+*/
+
+template <typename Key, typename Hash = std::hash<Key>, typename Eq = std::equal_to<>>
+class FlatHashSet {
+private:
+    static constexpr std::int8_t emptyCtrl = -128;   // 0b10000000
+    static constexpr std::int8_t deletedCtrl = -2;   // 0b11111110, full slots are 0..127
+    static constexpr std::size_t groupSize = 16;
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    std::vector<std::int8_t> ctrl;   // capacity control bytes, groups of 16
+    std::vector<Key> slots;
+    std::size_t count = 0;
+    std::size_t tombstones = 0;
+    std::size_t groupMask = 0;       // group count - 1
+    Hash hasher;
+    Eq eq;
+
+    // Bit i set for every byte i of the group that matches
+    struct Group {
+#if defined(__SSE2__) || defined(_M_X64)
+        __m128i bytes;
+        explicit Group(const std::int8_t* p) : bytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))) {}
+        std::uint32_t match(std::int8_t tag) const {
+            return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(tag))));
+        }
+        std::uint32_t matchEmpty() const { return match(emptyCtrl); }
+        // empty and deleted are the only bytes with the top bit set
+        std::uint32_t matchFree() const { return static_cast<std::uint32_t>(_mm_movemask_epi8(bytes)); }
+#else
+        // Same thing 8 bytes at a time in plain integers
+        std::uint64_t half[2];
+        explicit Group(const std::int8_t* p) { std::memcpy(half, p, sizeof(half)); }
+        static std::uint32_t highBits(std::uint64_t x) {
+            std::uint32_t m = 0;
+            for (int b = 0; b < 8; ++b) m |= static_cast<std::uint32_t>((x >> (8 * b + 7)) & 1) << b;
+            return m;
+        }
+        // exact zero byte test: high bit of a byte is set iff the byte was zero
+        static std::uint64_t zeroBytes(std::uint64_t x) {
+            constexpr std::uint64_t low7 = 0x7f7f7f7f7f7f7f7full;
+            return ~(((x & low7) + low7) | x | low7);
+        }
+        std::uint32_t match(std::int8_t tag) const {
+            std::uint64_t t = 0x0101010101010101ull * static_cast<std::uint8_t>(tag);
+            return highBits(zeroBytes(half[0] ^ t)) | (highBits(zeroBytes(half[1] ^ t)) << 8);
+        }
+        std::uint32_t matchEmpty() const { return match(emptyCtrl); }
+        std::uint32_t matchFree() const { return highBits(half[0]) | (highBits(half[1]) << 8); }
+#endif
+    };
+
+    static std::int8_t tagOf(std::size_t h) { return static_cast<std::int8_t>(h & 0x7f); }
+    std::size_t firstGroup(std::size_t h) const { return (h >> 7) & groupMask; }
+
+    // Slot holding key (hash already mixed), or npos
+    template <typename K>
+    std::size_t findSlot(const K& key, std::size_t h) const {
+        if (slots.empty()) return npos;
+        std::int8_t tag = tagOf(h);
+        std::size_t g = firstGroup(h);
+        for (std::size_t step = 1;; ++step) {
+            Group group(&ctrl[g * groupSize]);
+            for (std::uint32_t m = group.match(tag); m; m &= m - 1) {
+                std::size_t i = g * groupSize + static_cast<std::size_t>(std::countr_zero(m));
+                if (eq(slots[i], key)) return i;
+            }
+            if (group.matchEmpty()) return npos;
+            g = (g + step) & groupMask;   // triangular probing visits every group
+        }
+    }
+
+    // First empty or deleted slot on key's probe path
+    std::size_t freeSlot(std::size_t h) const {
+        std::size_t g = firstGroup(h);
+        for (std::size_t step = 1;; ++step) {
+            std::uint32_t m = Group(&ctrl[g * groupSize]).matchFree();
+            if (m) return g * groupSize + static_cast<std::size_t>(std::countr_zero(m));
+            g = (g + step) & groupMask;
+        }
+    }
+
+    void rehash(std::size_t newCapacity) {
+        std::vector<std::int8_t> oldCtrl = std::move(ctrl);
+        std::vector<Key> oldSlots = std::move(slots);
+        ctrl.assign(newCapacity, emptyCtrl);
+        slots = std::vector<Key>(newCapacity);
+        groupMask = newCapacity / groupSize - 1;
+        tombstones = 0;
+        for (std::size_t i = 0; i < oldSlots.size(); ++i) {
+            if (oldCtrl[i] < 0) continue;
+            std::size_t h = mix(hasher(oldSlots[i]));
+            std::size_t at = freeSlot(h);
+            ctrl[at] = tagOf(h);
+            slots[at] = std::move(oldSlots[i]);
+        }
+    }
+
+    // Room for one more key: grow at 7/8 full, or just clean out tombstones if they are most of it
+    void makeRoom() {
+        std::size_t cap = slots.size();
+        if ((count + tombstones + 1) * 8 <= cap * 7) return;
+        if (cap == 0) rehash(groupSize);
+        else if (tombstones > count / 2) rehash(cap);
+        else rehash(cap * 2);
+    }
+
+    template <typename K>
+    bool insertMixed(K&& key, std::size_t h) {
+        if (findSlot(key, h) != npos) return false;
+        makeRoom();
+        std::size_t at = freeSlot(h);
+        if (ctrl[at] == deletedCtrl) --tombstones;
+        ctrl[at] = tagOf(h);
+        slots[at] = std::forward<K>(key);
+        ++count;
+        return true;
+    }
+
+public:
+    FlatHashSet() = default;
+    explicit FlatHashSet(Hash h, Eq e = {}) : hasher(std::move(h)), eq(std::move(e)) {}
+
+    // Spreads a std::hash style value over all 64 bits (murmur3 finalizer)
+    static std::size_t mix(std::size_t h) {
+        std::uint64_t x = h;
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdull;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ull;
+        x ^= x >> 33;
+        return static_cast<std::size_t>(x);
+    }
+
+    // Adds key if it isn't there. Returns true if it was added.
+    bool insert(const Key& key) { return insertMixed(key, mix(hasher(key))); }
+    bool insert(Key&& key) {
+        std::size_t h = mix(hasher(key));
+        return insertMixed(std::move(key), h);
+    }
+    // Same, with hash = Hash()(key) already computed (e.g. to partition keys first)
+    bool insertHashed(const Key& key, std::size_t hash) { return insertMixed(key, mix(hash)); }
+
+    // K can be anything Hash and Eq accept next to Key
+    template <typename K>
+    bool contains(const K& key) const { return findSlot(key, mix(hasher(key))) != npos; }
+
+    template <typename K>
+    const Key* find(const K& key) const {
+        std::size_t i = findSlot(key, mix(hasher(key)));
+        return i == npos ? nullptr : &slots[i];
+    }
+
+    template <typename K>
+    bool erase(const K& key) {
+        std::size_t i = findSlot(key, mix(hasher(key)));
+        if (i == npos) return false;
+        // Probes only go past a group that has no empty slot, so in a group that has
+        // one the slot can go straight back to empty instead of becoming a tombstone
+        if (Group(&ctrl[i / groupSize * groupSize]).matchEmpty()) ctrl[i] = emptyCtrl;
+        else {
+            ctrl[i] = deletedCtrl;
+            ++tombstones;
+        }
+        slots[i] = Key{};
+        --count;
+        return true;
+    }
+
+    // Room for n keys without growing
+    void reserve(std::size_t n) {
+        std::size_t want = std::bit_ceil((n * 8 + 6) / 7 + 1);
+        if (want < groupSize) want = groupSize;
+        if (want > slots.size()) rehash(want);
+    }
+
+    void clear() {
+        ctrl.assign(ctrl.size(), emptyCtrl);
+        for (Key& k : slots) k = Key{};
+        count = 0;
+        tombstones = 0;
+    }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    std::size_t capacity() const { return slots.size(); }
+    std::size_t bytes() const { return ctrl.capacity() + slots.capacity() * sizeof(Key); }
+
+    // Forward iterator over the keys, in no particular order
+    class iterator {
+        const FlatHashSet* set = nullptr;
+        std::size_t i = 0;
+        void skipFree() {
+            while (i < set->slots.size() && set->ctrl[i] < 0) ++i;
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Key;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Key*;
+        using reference = const Key&;
+
+        iterator() = default;
+        iterator(const FlatHashSet* s, std::size_t at) : set(s), i(at) { skipFree(); }
+        const Key& operator*() const { return set->slots[i]; }
+        const Key* operator->() const { return &set->slots[i]; }
+        iterator& operator++() { ++i; skipFree(); return *this; }
+        iterator operator++(int) { iterator t = *this; ++*this; return t; }
+        bool operator==(const iterator& o) const { return i == o.i; }
+    };
+
+    iterator begin() const { return { this, 0 }; }
+    iterator end() const { return { this, slots.size() }; }
+};
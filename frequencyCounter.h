@@ -0,0 +1,374 @@
+#pragma once
+#include <algorithm>    // std::nth_element, std::sort, std::min
+#include <bit>          // std::bit_ceil
+#include <cstddef>      // std::size_t
+#include <cstdint>
+#include <functional>   // std::hash, std::equal_to
+#include <span>
+#include <thread>
+#include <utility>      // std::move, std::swap
+#include <vector>
+#include "flatHashSet.h"
+#include "threadPool.h"
+// NOT USING NAMESPACE STD FOR MORE ROBUST CODE
+
+/*
+8. FrequencyCounter (templated)
+    Use: Counts occurrences of items (words, IDs, events) and answers "how often did x
+         happen" and "what are the top K".
+    Steps: add(key) for every input → count(key) / percent(key) for one key →
+           topK(k) for the most frequent, biggest first.
+    Notes:
+        - CountMode::exact keeps every key with its count in a FlatHashSet (flat, no node per
+          key). Memory grows with the number of distinct keys.
+        - CountMode::bounded uses fixed memory however many distinct keys there are:
+            SpaceSaving   tracks trackTop keys. A new key takes over the smallest counter and
+                          inherits its count as "error", so count is never too low and
+                          count - error never too high. Every key more frequent than
+                          total / trackTop is guaranteed to be in there.
+            CountMinSketch  depth rows of width counters, count(key) is the smallest of the key's
+                          depth cells: never too low, too high by at most ~2 * total / width with
+                          high probability.
+          count(key) gives the tighter of the two; FrequencyItem::error says how far off a
+          top-K count can be.
+        - Counters merge: merge(other) adds another counter of the same shape, so every thread
+          can count its own part and the results are combined at the end (addParallel does
+          exactly that on a ThreadPool). Bounded merges stay within their error bounds.
+        - topK selects with nth_element and only sorts the K it returns.
+        - Key must be default constructible (FlatHashSet slots).
+*/
+
+enum class CountMode { exact, bounded };
+
+// count - error <= true count <= count (error is 0 in exact mode)
+template <typename Key>
+struct FrequencyItem {
+    Key key{};
+    std::uint64_t count = 0;
+    std::uint64_t error = 0;
+};
+
+template <typename Key, typename Hash = std::hash<Key>>
+class CountMinSketch {
+private:
+    std::vector<std::uint64_t> cells;   // depth rows of width
+    std::size_t width;
+    std::size_t mask;
+    std::size_t depth;
+    Hash hasher;
+
+    // Row r uses h1 + r * h2 (double hashing), h is already mixed
+    std::size_t cell(std::size_t r, std::size_t h) const {
+        std::size_t h1 = h & 0xffffffffu, h2 = (h >> 32) | 1;
+        return r * width + ((h1 + r * h2) & mask);
+    }
+
+public:
+    explicit CountMinSketch(std::size_t w = std::size_t(1) << 16, std::size_t d = 4, Hash h = {})
+        : width(std::bit_ceil(w < 16 ? std::size_t(16) : w)), mask(width - 1), depth(d < 1 ? 1 : d), hasher(std::move(h)) {
+        cells.assign(width * depth, 0);
+    }
+
+    template <typename K>
+    void add(const K& key, std::uint64_t n = 1) { addHashed(FlatHashSet<std::size_t>::mix(hasher(key)), n); }
+    // h = mixed hash, for callers that hash the key once for several structures
+    void addHashed(std::size_t h, std::uint64_t n = 1) {
+        for (std::size_t r = 0; r < depth; ++r) cells[cell(r, h)] += n;
+    }
+
+    template <typename K>
+    std::uint64_t estimate(const K& key) const { return estimateHashed(FlatHashSet<std::size_t>::mix(hasher(key))); }
+    std::uint64_t estimateHashed(std::size_t h) const {
+        std::uint64_t best = cells[cell(0, h)];
+        for (std::size_t r = 1; r < depth; ++r) best = std::min(best, cells[cell(r, h)]);
+        return best;
+    }
+
+    // Cell-wise sum. false (and nothing changes) if the shapes differ.
+    bool merge(const CountMinSketch& o) {
+        if (o.width != width || o.depth != depth) return false;
+        for (std::size_t i = 0; i < cells.size(); ++i) cells[i] += o.cells[i];
+        return true;
+    }
+
+    void clear() { cells.assign(cells.size(), 0); }
+    std::size_t rowWidth() const { return width; }
+    std::size_t rows() const { return depth; }
+    std::size_t bytes() const { return cells.capacity() * sizeof(std::uint64_t); }
+};
+
+template <typename Key, typename Hash = std::hash<Key>, typename Eq = std::equal_to<>>
+class FrequencyCounter {
+private:
+    // FlatHashSet entries that carry a value next to the key; hashed and compared by key only.
+    // The value is mutable because the set hands out const pointers.
+    template <typename V>
+    struct Keyed {
+        Key key{};
+        mutable V value{};
+    };
+    struct KeyHash {
+        Hash h;
+        template <typename V>
+        std::size_t operator()(const Keyed<V>& e) const { return h(e.key); }
+        std::size_t operator()(const Key& k) const { return h(k); }
+    };
+    struct KeyEq {
+        Eq eq;
+        template <typename V>
+        bool operator()(const Keyed<V>& a, const Keyed<V>& b) const { return eq(a.key, b.key); }
+        template <typename V>
+        bool operator()(const Keyed<V>& a, const Key& k) const { return eq(a.key, k); }
+    };
+    template <typename V>
+    using KeyedSet = FlatHashSet<Keyed<V>, KeyHash, KeyEq>;
+
+    // Space-Saving: at most cap counters, a min-heap on count finds the one to take over
+    class SpaceSaving {
+    private:
+        std::vector<FrequencyItem<Key>> counters;
+        std::vector<std::uint32_t> heap;      // counter numbers, smallest count first
+        std::vector<std::uint32_t> heapPos;   // counter number -> heap slot
+        KeyedSet<std::uint32_t> index;        // key -> counter number
+        std::size_t cap;
+
+        bool less(std::uint32_t a, std::uint32_t b) const { return counters[a].count < counters[b].count; }
+        void place(std::size_t at, std::uint32_t c) {
+            heap[at] = c;
+            heapPos[c] = static_cast<std::uint32_t>(at);
+        }
+        // Counts only grow, so a counter only ever moves down
+        void siftDown(std::size_t at) {
+            std::uint32_t c = heap[at];
+            std::size_t n = heap.size();
+            while (true) {
+                std::size_t child = 2 * at + 1;
+                if (child >= n) break;
+                if (child + 1 < n && less(heap[child + 1], heap[child])) ++child;
+                if (!less(heap[child], c)) break;
+                place(at, heap[child]);
+                at = child;
+            }
+            place(at, c);
+        }
+
+        void rebuild(std::vector<FrequencyItem<Key>> items) {
+            counters = std::move(items);
+            index.clear();
+            heap.resize(counters.size());
+            heapPos.resize(counters.size());
+            for (std::size_t i = 0; i < counters.size(); ++i) {
+                place(i, static_cast<std::uint32_t>(i));
+                index.insert({ counters[i].key, static_cast<std::uint32_t>(i) });
+            }
+            for (std::size_t i = heap.size() / 2; i-- > 0;) siftDown(i);
+        }
+
+    public:
+        SpaceSaving(std::size_t capacity, const Hash& h, const Eq& e) : index(KeyHash{ h }, KeyEq{ e }), cap(capacity < 1 ? 1 : capacity) {
+            counters.reserve(cap);
+            heap.reserve(cap);
+            heapPos.reserve(cap);
+            index.reserve(cap);
+        }
+
+        void add(const Key& key, std::uint64_t n, std::size_t rawHash) {
+            if (const Keyed<std::uint32_t>* hit = index.find(key)) {
+                counters[hit->value].count += n;
+                siftDown(heapPos[hit->value]);
+                return;
+            }
+            if (counters.size() < cap) {
+                std::uint32_t c = static_cast<std::uint32_t>(counters.size());
+                counters.push_back({ key, n, 0 });
+                heap.push_back(c);
+                heapPos.push_back(0);
+                // a new counter can be smaller than its parent, move it up
+                std::size_t at = heap.size() - 1;
+                while (at > 0 && less(c, heap[(at - 1) / 2])) {
+                    place(at, heap[(at - 1) / 2]);
+                    at = (at - 1) / 2;
+                }
+                place(at, c);
+                index.insertHashed({ key, c }, rawHash);
+                return;
+            }
+            // take over the smallest counter, its count becomes the new key's error
+            std::uint32_t c = heap[0];
+            FrequencyItem<Key>& victim = counters[c];
+            index.erase(victim.key);
+            victim.error = victim.count;
+            victim.count += n;
+            victim.key = key;
+            index.insertHashed({ key, c }, rawHash);
+            siftDown(0);
+        }
+
+        const FrequencyItem<Key>* find(const Key& key) const {
+            const Keyed<std::uint32_t>* hit = index.find(key);
+            return hit ? &counters[hit->value] : nullptr;
+        }
+
+        // Smallest count a key missing from the summary could have had (0 until it is full)
+        std::uint64_t floor() const { return counters.size() < cap ? 0 : counters[heap[0]].count; }
+
+        // Mergeable summaries: a key missing on one side may have had up to that side's floor,
+        // so it gets that added to both count and error. Then the biggest cap survive.
+        void merge(const SpaceSaving& o) {
+            std::uint64_t mine = floor(), theirs = o.floor();
+            std::vector<FrequencyItem<Key>> all;
+            all.reserve(counters.size() + o.counters.size());
+            for (const FrequencyItem<Key>& a : counters) {
+                const FrequencyItem<Key>* b = o.find(a.key);
+                all.push_back({ a.key, a.count + (b ? b->count : theirs), a.error + (b ? b->error : theirs) });
+            }
+            for (const FrequencyItem<Key>& b : o.counters)
+                if (!find(b.key)) all.push_back({ b.key, b.count + mine, b.error + mine });
+            if (all.size() > cap) {
+                std::nth_element(all.begin(), all.begin() + static_cast<std::ptrdiff_t>(cap), all.end(),
+                                 [](const FrequencyItem<Key>& x, const FrequencyItem<Key>& y) { return x.count > y.count; });
+                all.resize(cap);
+            }
+            rebuild(std::move(all));
+        }
+
+        const std::vector<FrequencyItem<Key>>& items() const { return counters; }
+        std::size_t capacity() const { return cap; }
+        std::size_t bytes() const {
+            return counters.capacity() * sizeof(FrequencyItem<Key>) + (heap.capacity() + heapPos.capacity()) * sizeof(std::uint32_t) + index.bytes();
+        }
+        void clear() { rebuild({}); }
+    };
+
+    CountMode countMode;
+    Hash hasher;
+    Eq eq;
+    KeyedSet<std::uint64_t> exactCounts;
+    SpaceSaving top;
+    CountMinSketch<Key, Hash> sketch;
+    std::uint64_t totalCount = 0;
+
+    // Same mode and shape, nothing counted
+    FrequencyCounter emptyLike() const {
+        return FrequencyCounter(countMode, top.capacity(), sketch.rowWidth(), sketch.rows(), hasher, eq);
+    }
+
+    static std::vector<FrequencyItem<Key>> biggest(std::vector<FrequencyItem<Key>> items, std::size_t k) {
+        auto more = [](const FrequencyItem<Key>& a, const FrequencyItem<Key>& b) { return a.count > b.count; };
+        if (k < items.size()) {
+            std::nth_element(items.begin(), items.begin() + static_cast<std::ptrdiff_t>(k), items.end(), more);
+            items.resize(k);
+        }
+        std::sort(items.begin(), items.end(), more);
+        return items;
+    }
+
+public:
+    // trackTop, sketchWidth and sketchDepth only matter in bounded mode (exact mode keeps a
+    // minimal sketch and summary that are never touched).
+    explicit FrequencyCounter(CountMode mode = CountMode::exact, std::size_t trackTop = 1024, std::size_t sketchWidth = std::size_t(1) << 16,
+                              std::size_t sketchDepth = 4, Hash h = {}, Eq e = {})
+        : countMode(mode), hasher(h), eq(e), exactCounts(KeyHash{ h }, KeyEq{ e }),
+          top(mode == CountMode::bounded ? trackTop : 1, h, e),
+          sketch(mode == CountMode::bounded ? sketchWidth : 1, mode == CountMode::bounded ? sketchDepth : 1, h) {}
+
+    void add(const Key& key, std::uint64_t n = 1) {
+        totalCount += n;
+        if (countMode == CountMode::exact) {
+            if (const Keyed<std::uint64_t>* hit = exactCounts.find(key)) hit->value += n;
+            else exactCounts.insert({ key, n });
+            return;
+        }
+        std::size_t h = hasher(key);
+        sketch.addHashed(FlatHashSet<std::size_t>::mix(h), n);
+        top.add(key, n, h);
+    }
+
+    template <typename Range>
+    void addAll(const Range& keys) {
+        for (const Key& k : keys) add(k);
+    }
+
+    // Splits keys over the pool, one counter per thread, merged into this one at the end
+    void addParallel(std::span<const Key> keys, ThreadPool& pool) {
+        std::size_t parts = pool.size() + 1;
+        std::vector<FrequencyCounter> partial;
+        partial.reserve(parts);
+        for (std::size_t p = 0; p < parts; ++p) partial.push_back(emptyLike());
+        ThreadPool::TaskGroup group(pool);
+        for (std::size_t p = 0; p < parts; ++p) {
+            group.run([&, p] {
+                std::size_t lo = keys.size() * p / parts, hi = keys.size() * (p + 1) / parts;
+                for (std::size_t i = lo; i < hi; ++i) partial[p].add(keys[i]);
+            });
+        }
+        group.wait();
+        for (const FrequencyCounter& c : partial) merge(c);
+    }
+
+    // threads = 0 means one per hardware thread
+    void addParallel(std::span<const Key> keys, std::size_t threads = 0) {
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        if (threads == 1) return addAll(keys);
+        ThreadPool pool(threads - 1);   // the calling thread is the last one
+        addParallel(keys, pool);
+    }
+
+    // Adds other's counts. false (and nothing changes) if the mode or shape differs.
+    bool merge(const FrequencyCounter& o) {
+        if (o.countMode != countMode) return false;
+        if (countMode == CountMode::exact) {
+            exactCounts.reserve(exactCounts.size() + o.exactCounts.size());
+            for (const Keyed<std::uint64_t>& e : o.exactCounts) {
+                if (const Keyed<std::uint64_t>* hit = exactCounts.find(e.key)) hit->value += e.value;
+                else exactCounts.insert(e);
+            }
+        }
+        else {
+            if (o.top.capacity() != top.capacity() || !sketch.merge(o.sketch)) return false;
+            top.merge(o.top);
+        }
+        totalCount += o.totalCount;
+        return true;
+    }
+
+    // Exact count, or in bounded mode an estimate that is never too low
+    std::uint64_t count(const Key& key) const {
+        if (countMode == CountMode::exact) {
+            const Keyed<std::uint64_t>* hit = exactCounts.find(key);
+            return hit ? hit->value : 0;
+        }
+        std::uint64_t est = sketch.estimate(key);
+        if (const FrequencyItem<Key>* t = top.find(key)) est = std::min(est, t->count);
+        return est;
+    }
+
+    double percent(const Key& key) const {
+        return totalCount ? 100.0 * static_cast<double>(count(key)) / static_cast<double>(totalCount) : 0.0;
+    }
+
+    // The k most frequent, biggest first. Bounded mode can only return tracked keys (trackTop).
+    std::vector<FrequencyItem<Key>> topK(std::size_t k) const {
+        if (countMode == CountMode::bounded) return biggest(top.items(), k);
+        std::vector<FrequencyItem<Key>> items;
+        items.reserve(exactCounts.size());
+        for (const Keyed<std::uint64_t>& e : exactCounts) items.push_back({ e.key, e.value, 0 });
+        return biggest(std::move(items), k);
+    }
+
+    // Every counted (exact) or tracked (bounded) key, biggest first
+    std::vector<FrequencyItem<Key>> sorted() const { return topK(distinct()); }
+
+    void clear() {
+        exactCounts.clear();
+        top.clear();
+        sketch.clear();
+        totalCount = 0;
+    }
+
+    std::uint64_t total() const { return totalCount; }
+    // Distinct keys (exact) or keys currently tracked (bounded)
+    std::size_t distinct() const { return countMode == CountMode::exact ? exactCounts.size() : top.items().size(); }
+    CountMode mode() const { return countMode; }
+    std::size_t bytes() const { return exactCounts.bytes() + top.bytes() + sketch.bytes(); }
+};
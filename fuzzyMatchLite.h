@@ -0,0 +1,412 @@
+#pragma once
+#include <algorithm>    // std::sort, std::push_heap, std::lower_bound, std::binary_search
+#include <array>
+#include <cstddef>      // std::size_t
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>      // std::swap, std::move, std::pair
+#include <vector>
+#include "caseFold.h"
+// NOT USING NAMESPACE STD FOR MORE ROBUST CODE
+
+/*
+14. FuzzyMatchLite
+    Use: "Did you mean ...?" for commands, names and ids, typo tolerant, fast enough for
+         dictionaries with hundreds of thousands of entries.
+    Steps: Fold the query like search_ci does (ASCII case) → compile it once into a bit
+           pattern (FuzzyPattern) → FuzzyIndex picks the few candidates that can be within
+           maxDistance edits from the bigrams they share with the query → the bit-parallel
+           distance scores each candidate and gives up as soon as it can't get under the
+           limit → keep the best limit matches.
+    Notes:
+        - Distance is Levenshtein (insert, delete, substitute, each costs 1). Queries up to
+          64 bytes use Myers' bit-parallel algorithm: one 64 bit word per text character,
+          so a 10 letter name costs about 10 steps instead of 100 DP cells. Longer ones
+          use a banded DP that only fills the 2 * maxDistance + 1 diagonals around the middle.
+        - Both stop early: a length difference above the limit costs nothing, and once
+          the current distance minus what is left of the text is over the limit it returns.
+        - FuzzyIndex keeps the words ordered by length, so a query only ever looks at
+          words within maxDistance of its own length. An edit breaks at most 2 bigrams,
+          so a word within k edits shares at least (query bigrams - 2k) of them; only
+          those get scored. Queries too short for that bound scan their length window.
+        - Case folding is CaseFold's: 'A'..'Z' only, other bytes compare as they are.
+        - Results: best first by distance, then score (1 - distance / longer length),
+          then input position. index is the position in the list the index was built from.
+        - FuzzyIndex::find is const and can be called from many threads at once.
+*/
+
+// One hit. text points into the candidate list (scan) or the index.
+struct FuzzyMatch {
+    std::size_t index = 0;
+    std::string_view text;
+    std::size_t distance = 0;
+    double score = 0;
+};
+
+struct FuzzyOptions {
+    std::size_t maxDistance = 2;   // accept up to this many edits
+    std::size_t limit = 5;         // best matches to return, 0 = all within maxDistance
+};
+
+// The query, compiled once and matched against many texts
+class FuzzyPattern {
+private:
+    std::string folded;
+    std::array<std::uint64_t, 256> peq{};   // bit i set where query[i] matches the byte
+    bool caseInsensitive;
+
+    static unsigned char fold(unsigned char c) { return (c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c | 0x20) : c; }
+
+public:
+    explicit FuzzyPattern(std::string_view query, bool caseInsensitive = true)
+        : folded(caseInsensitive ? CaseFold::lower(query) : std::string(query)), caseInsensitive(caseInsensitive) {
+        if (folded.size() > 64) return;
+        for (std::size_t i = 0; i < folded.size(); ++i) {
+            unsigned char c = static_cast<unsigned char>(folded[i]);
+            peq[c] |= std::uint64_t(1) << i;
+            if (caseInsensitive && c >= 'a' && c <= 'z') peq[c & ~0x20u] |= std::uint64_t(1) << i;
+        }
+    }
+
+    std::size_t size() const { return folded.size(); }
+    std::string_view text() const { return folded; }
+
+    // Edit distance to text, or maxDistance + 1 as soon as it is sure to be more
+    std::size_t distance(std::string_view text, std::size_t maxDistance) const {
+        const std::size_t m = folded.size(), n = text.size();
+        const std::size_t over = maxDistance + 1;
+        if ((m > n ? m - n : n - m) > maxDistance) return over;
+        if (m == 0) return n;
+        if (m > 64) return banded(folded, text, maxDistance, caseInsensitive);
+
+        // Myers / Hyyro: vertical deltas of the DP column as bit vectors (pv = +1, mv = -1)
+        const std::uint64_t last = std::uint64_t(1) << (m - 1);
+        std::uint64_t pv = ~std::uint64_t(0), mv = 0;
+        std::size_t score = m;
+        for (std::size_t j = 0; j < n; ++j) {
+            std::uint64_t eq = peq[static_cast<unsigned char>(text[j])];
+            std::uint64_t xv = eq | mv;
+            std::uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+            std::uint64_t ph = mv | ~(xh | pv);
+            std::uint64_t mh = pv & xh;
+            if (ph & last) ++score;
+            else if (mh & last) --score;
+            ph = (ph << 1) | 1;   // row 0 grows by one per column
+            mh <<= 1;
+            pv = mh | ~(xv | ph);
+            mv = ph & xv;
+            // every remaining column can lower the score by at most one
+            if (score > maxDistance + (n - j - 1)) return over;
+        }
+        return score <= maxDistance ? score : over;
+    }
+
+    // Ukkonen band: only cells with |i - j| <= maxDistance, stops once a whole row is over
+    static std::size_t banded(std::string_view a, std::string_view b, std::size_t maxDistance, bool caseInsensitive) {
+        const std::size_t m = a.size(), n = b.size();
+        const std::size_t over = maxDistance + 1;
+        if ((m > n ? m - n : n - m) > maxDistance) return over;
+
+        std::vector<std::size_t> prev(n + 2, over), cur(n + 2, over);
+        for (std::size_t j = 0; j <= n && j <= maxDistance; ++j) prev[j] = j;
+        for (std::size_t i = 1; i <= m; ++i) {
+            std::size_t lo = i > maxDistance ? i - maxDistance : 0;
+            std::size_t hi = std::min(n, i + maxDistance);
+            std::size_t rowMin = over;
+            if (lo == 0) rowMin = cur[0] = std::min(i, over);
+            else cur[lo - 1] = over;
+            unsigned char ca = static_cast<unsigned char>(a[i - 1]);
+            if (caseInsensitive) ca = fold(ca);
+            for (std::size_t j = lo > 1 ? lo : 1; j <= hi; ++j) {
+                unsigned char cb = static_cast<unsigned char>(b[j - 1]);
+                if (caseInsensitive) cb = fold(cb);
+                std::size_t v = prev[j - 1] + (ca != cb);
+                v = std::min(v, prev[j] + 1);
+                v = std::min(v, cur[j - 1] + 1);
+                cur[j] = std::min(v, over);
+                rowMin = std::min(rowMin, cur[j]);
+            }
+            if (rowMin > maxDistance) return over;
+            cur[hi + 1] = over;   // the next row reads one cell past this band
+            std::swap(prev, cur);
+        }
+        return std::min(prev[n], over);
+    }
+};
+
+// Plain distance functions
+class EditDistance {
+public:
+    // Exact Levenshtein distance
+    static std::size_t levenshtein(std::string_view a, std::string_view b, bool caseInsensitive = false) {
+        return bounded(a, b, std::max(a.size(), b.size()), caseInsensitive);
+    }
+
+    // Distance if it is <= maxDistance, otherwise maxDistance + 1 (found out early)
+    static std::size_t bounded(std::string_view a, std::string_view b, std::size_t maxDistance, bool caseInsensitive = false) {
+        if (a.size() > b.size()) std::swap(a, b);
+        if (a.size() > 64) return FuzzyPattern::banded(a, b, maxDistance, caseInsensitive);
+        return FuzzyPattern(a, caseInsensitive).distance(b, maxDistance);
+    }
+};
+
+// Keeps the best limit matches, shared by the scan and the index
+class FuzzyTopK {
+private:
+    std::vector<FuzzyMatch> heap;   // worst match on top
+    FuzzyOptions opt;
+
+public:
+    explicit FuzzyTopK(FuzzyOptions o) : opt(o) {}
+
+    static bool better(const FuzzyMatch& a, const FuzzyMatch& b) {
+        if (a.distance != b.distance) return a.distance < b.distance;
+        if (a.score != b.score) return a.score > b.score;
+        return a.index < b.index;
+    }
+
+    // Anything further away than this can't get in anymore
+    std::size_t bound() const {
+        return opt.limit && heap.size() == opt.limit ? heap.front().distance : opt.maxDistance;
+    }
+
+    void offer(std::size_t index, std::string_view text, std::size_t distance, std::size_t queryLength) {
+        std::size_t longer = std::max(queryLength, text.size());
+        FuzzyMatch m{ index, text, distance, longer ? 1.0 - static_cast<double>(distance) / static_cast<double>(longer) : 1.0 };
+        if (opt.limit == 0 || heap.size() < opt.limit) {
+            heap.push_back(m);
+            if (opt.limit) std::push_heap(heap.begin(), heap.end(), better);
+        }
+        else if (better(m, heap.front())) {
+            std::pop_heap(heap.begin(), heap.end(), better);
+            heap.back() = m;
+            std::push_heap(heap.begin(), heap.end(), better);
+        }
+    }
+
+    std::vector<FuzzyMatch> finish() {
+        std::sort(heap.begin(), heap.end(), better);
+        return std::move(heap);
+    }
+};
+
+class FuzzyMatchLite {
+public:
+    // No index: scores every candidate (with the early exits). Fine for a few thousand.
+    template <typename Container>
+    static std::vector<FuzzyMatch> find(const Container& candidates, std::string_view query, FuzzyOptions opt = {},
+                                        bool caseInsensitive = true) {
+        FuzzyPattern p(query, caseInsensitive);
+        FuzzyTopK top(opt);
+        std::size_t i = 0;
+        for (const auto& c : candidates) {
+            std::string_view text(c);
+            std::size_t d = p.distance(text, top.bound());
+            if (d <= top.bound()) top.offer(i, text, d, p.size());
+            ++i;
+        }
+        return top.finish();
+    }
+
+    // Best single match, found = false if nothing is within maxDistance
+    template <typename Container>
+    static bool best(const Container& candidates, std::string_view query, FuzzyMatch& out, std::size_t maxDistance = 2,
+                     bool caseInsensitive = true) {
+        std::vector<FuzzyMatch> m = find(candidates, query, { maxDistance, 1 }, caseInsensitive);
+        if (m.empty()) return false;
+        out = m[0];
+        return true;
+    }
+};
+
+/*
+FuzzyIndex
+    Use: Build once over a big word list, then answer many fuzzy lookups.
+    Steps: Fold every word → order the words by length (the id is the rank in that order) →
+           for each bigram of the padded word ("\0ab\0") add the id to that bigram's posting
+           list → a query takes the id range of the allowed lengths out of each of its
+           bigrams' lists, counts shared bigrams per word (rarest lists first, the common ones
+           only count words already seen) → scores the words that reach the bound, most
+           shared bigrams first so the top-k limit tightens quickly.
+    Notes:
+        - Memory: the words twice (as given and folded) plus 4 bytes per distinct bigram
+          per word.
+*/
+
+class FuzzyIndex {
+private:
+    std::string original;               // words as given, in id order
+    std::string folded;                 // folded copy (empty when case sensitive)
+    std::vector<std::size_t> offsets;   // id -> start in original/folded, offsets[n] = end
+    std::vector<std::uint32_t> inputIndex;   // id -> position in the list given to the constructor
+    std::vector<std::uint32_t> firstOfLength;  // length -> first id with that length (or longer)
+    std::vector<std::uint32_t> postingStart;   // bigram -> start in postings, 65536 + 1 entries
+    std::vector<std::uint32_t> postings;       // ids, ascending within each bigram
+    bool caseInsensitive = true;
+
+    std::string_view word(std::uint32_t id) const {
+        return std::string_view(caseInsensitive ? folded : original).substr(offsets[id], offsets[id + 1] - offsets[id]);
+    }
+    std::string_view originalWord(std::uint32_t id) const {
+        return std::string_view(original).substr(offsets[id], offsets[id + 1] - offsets[id]);
+    }
+
+    // Distinct bigrams of "\0" + s + "\0", sorted
+    static void bigrams(std::string_view s, std::vector<std::uint16_t>& out) {
+        out.clear();
+        unsigned char prev = 0;
+        for (char ch : s) {
+            unsigned char c = static_cast<unsigned char>(ch);
+            out.push_back(static_cast<std::uint16_t>(prev << 8 | c));
+            prev = c;
+        }
+        out.push_back(static_cast<std::uint16_t>(prev << 8));
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+    }
+
+    // First id whose length is >= len
+    std::uint32_t idsFromLength(std::size_t len) const {
+        return len < firstOfLength.size() ? firstOfLength[len] : static_cast<std::uint32_t>(inputIndex.size());
+    }
+
+public:
+    FuzzyIndex() : postingStart(65537, 0) {}
+
+    template <typename Container>
+    explicit FuzzyIndex(const Container& words, bool caseInsensitive = true) : caseInsensitive(caseInsensitive) {
+        std::vector<std::string_view> views;
+        for (const auto& w : words) views.emplace_back(w);
+        const std::size_t n = views.size();
+
+        // Counting sort by length, stable so equal lengths keep their input order
+        std::size_t maxLen = 0;
+        for (std::string_view v : views) maxLen = std::max(maxLen, v.size());
+        firstOfLength.assign(maxLen + 2, 0);
+        for (std::string_view v : views) ++firstOfLength[v.size() + 1];
+        for (std::size_t l = 1; l < firstOfLength.size(); ++l) firstOfLength[l] += firstOfLength[l - 1];
+        std::vector<std::uint32_t> next(firstOfLength.begin(), firstOfLength.end() - 1);
+        inputIndex.resize(n);
+        for (std::size_t i = 0; i < n; ++i) inputIndex[next[views[i].size()]++] = static_cast<std::uint32_t>(i);
+
+        offsets.resize(n + 1);
+        for (std::size_t id = 0; id < n; ++id) {
+            offsets[id] = original.size();
+            original += views[inputIndex[id]];
+        }
+        offsets[n] = original.size();
+        if (caseInsensitive) folded = CaseFold::lower(original);
+
+        // Two passes over the bigrams: sizes, then fill. Ids go in ascending.
+        std::vector<std::uint16_t> grams;
+        postingStart.assign(65537, 0);
+        for (std::uint32_t id = 0; id < n; ++id) {
+            bigrams(word(id), grams);
+            for (std::uint16_t g : grams) ++postingStart[g + 1];
+        }
+        for (std::size_t g = 1; g < postingStart.size(); ++g) postingStart[g] += postingStart[g - 1];
+        postings.resize(postingStart.back());
+        std::vector<std::uint32_t> fill(postingStart.begin(), postingStart.end() - 1);
+        for (std::uint32_t id = 0; id < n; ++id) {
+            bigrams(word(id), grams);
+            for (std::uint16_t g : grams) postings[fill[g]++] = id;
+        }
+    }
+
+    std::size_t size() const { return inputIndex.size(); }
+
+    std::size_t bytes() const {
+        return original.capacity() + folded.capacity() + offsets.capacity() * sizeof(std::size_t) +
+               (inputIndex.capacity() + firstOfLength.capacity() + postingStart.capacity() + postings.capacity()) * 4;
+    }
+
+    std::vector<FuzzyMatch> find(std::string_view query, FuzzyOptions opt = {}) const {
+        FuzzyPattern p(query, caseInsensitive);
+        FuzzyTopK top(opt);
+        const std::size_t m = p.size(), k = opt.maxDistance;
+        const std::uint32_t lo = idsFromLength(m > k ? m - k : 0);
+        const std::uint32_t hi = idsFromLength(m + k + 1);
+        if (lo >= hi) return top.finish();
+
+        auto score = [&](std::uint32_t id) {
+            std::size_t d = p.distance(word(id), top.bound());
+            if (d <= top.bound()) top.offer(inputIndex[id], originalWord(id), d, m);
+        };
+
+        thread_local std::vector<std::uint16_t> grams;
+        bigrams(p.text(), grams);
+        const std::size_t need = grams.size() > 2 * k ? grams.size() - 2 * k : 0;
+        if (need == 0) {
+            // too short to filter by bigrams, every word of a fitting length
+            for (std::uint32_t id = lo; id < hi; ++id) score(id);
+            return top.finish();
+        }
+
+        // [first, last) of each bigram's list inside the length window, rarest first
+        struct Range {
+            const std::uint32_t* first;
+            const std::uint32_t* last;
+        };
+        std::vector<Range> lists;
+        lists.reserve(grams.size());
+        for (std::uint16_t g : grams) {
+            const std::uint32_t* b = postings.data() + postingStart[g];
+            const std::uint32_t* e = postings.data() + postingStart[g + 1];
+            lists.push_back({ std::lower_bound(b, e, lo), std::lower_bound(b, e, hi) });
+        }
+        std::sort(lists.begin(), lists.end(), [](const Range& a, const Range& b) { return a.last - a.first < b.last - b.first; });
+
+        // A word with need shared bigrams has one in the first (lists - need + 1) lists
+        thread_local std::vector<std::uint32_t> hits;
+        thread_local std::vector<std::uint32_t> seen;
+        if (hits.size() < inputIndex.size()) hits.resize(inputIndex.size(), 0);
+        seen.clear();
+        const std::size_t seeds = lists.size() - need + 1;
+        for (std::size_t l = 0; l < seeds; ++l) {
+            for (const std::uint32_t* it = lists[l].first; it != lists[l].last; ++it) {
+                if (hits[*it]++ == 0) seen.push_back(*it);
+            }
+        }
+        for (std::size_t l = seeds; l < lists.size(); ++l) {
+            // drop the words that can't reach need even if they are in every list left
+            const std::size_t left = lists.size() - l;
+            std::size_t keep = 0;
+            for (std::uint32_t id : seen) {
+                if (hits[id] + left >= need) seen[keep++] = id;
+                else hits[id] = 0;
+            }
+            seen.resize(keep);
+
+            const Range& r = lists[l];
+            if (static_cast<std::size_t>(r.last - r.first) > 8 * seen.size()) {
+                // long common list: look the candidates up in it instead of walking it
+                for (std::uint32_t id : seen) hits[id] += std::binary_search(r.first, r.last, id);
+            }
+            else {
+                for (const std::uint32_t* it = r.first; it != r.last; ++it) {
+                    if (hits[*it]) ++hits[*it];
+                }
+            }
+        }
+
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> candidates;   // (shared bigrams, id)
+        for (std::uint32_t id : seen) {
+            if (hits[id] >= need) candidates.push_back({ hits[id], id });
+            hits[id] = 0;
+        }
+        std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) {
+            return a.first != b.first ? a.first > b.first : a.second < b.second;
+        });
+        for (const auto& c : candidates) score(c.second);
+        return top.finish();
+    }
+
+    // Best single match, false if nothing is within maxDistance
+    bool best(std::string_view query, FuzzyMatch& out, std::size_t maxDistance = 2) const {
+        std::vector<FuzzyMatch> m = find(query, { maxDistance, 1 });
+        if (m.empty()) return false;
+        out = m[0];
+        return true;
+    }
+};
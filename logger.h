@@ -0,0 +1,468 @@
+#pragma once
+#include <algorithm>    // std::stable_sort, std::min, std::find
+#include <atomic>
+#include <charconv>     // std::to_chars
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>      // std::size_t
+#include <cstdint>
+#include <cstdio>       // std::FILE, std::fopen, std::fwrite
+#include <cstring>      // std::memcpy, std::strlen
+#include <ctime>        // std::gmtime
+#include <functional>   // std::function
+#include <memory>       // std::unique_ptr, std::shared_ptr
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>      // std::move, std::swap
+#include <vector>
+#include "ringBuffer.h"
+// NOT USING NAMESPACE STD FOR MORE ROBUST CODE
+
+/*
+26. Logger (levels + sinks)
+    Use: Log from hot paths and worker threads without paying for formatting or I/O there.
+    Steps: log.info("sorted {} items in {} ms", n, ms) → the call site copies a timestamp, the
+           level, the format string's address and the raw arguments into a fixed size record
+           → pushes it into its own thread's SpscRing (no lock, nothing shared with other
+           threads) → a background thread drains every ring, sorts the batch by time, does
+           the "{}" formatting and hands one big string to each sink (console, file, ...).
+    Notes:
+        - The format string is stored as a pointer, so it must be a string literal (or
+          outlive the logger). String arguments are copied (up to textBytes per record in
+          total, longer ones are cut and end in "...").
+        - Up to maxArgs arguments: integers, floats, bool, char, enums, strings, pointers.
+        - Levels below LOGGER_MIN_LEVEL (define it before including, 0 = trace ... 5 = off)
+          are removed at compile time: the template versions compile to nothing, the
+          LOG_DEBUG(...) style macros don't even evaluate their arguments. setLevel() filters
+          at run time on top of that.
+        - A full ring drops the record and counts it (dropped()), so a slow disk never stalls
+          the caller. LogOverflow::block waits for room instead.
+        - flush() returns once everything logged before it has reached the sinks. The
+          destructor flushes too.
+        - Every thread that logs gets one ring per logger (perThreadRecords * 256 bytes), also
+          when it switches between loggers. When the thread ends its ring goes back to the
+          logger and the next new thread gets it, so short lived pools don't add up. The
+          "[n]" in a line is the ring's number, not an OS thread id.
+*/
+
+#ifndef LOGGER_MIN_LEVEL
+#define LOGGER_MIN_LEVEL 0
+#endif
+
+enum class LogLevel : std::uint8_t { trace, debug, info, warn, error, off };
+enum class LogOverflow { drop, block };
+
+class Logger {
+public:
+    static constexpr std::size_t maxArgs = 8;
+    static constexpr std::size_t textBytes = 160;
+    static constexpr int minLevel = LOGGER_MIN_LEVEL;
+
+    // Compile time filter, also used by the LOG_INFO(...) style macros
+    static constexpr bool enabled(LogLevel l) { return static_cast<int>(l) >= minLevel && l != LogLevel::off; }
+
+    using Sink = std::function<void(std::string_view)>;
+
+private:
+    enum class ArgType : std::uint8_t { i64, u64, f64, boolean, character, text, pointer };
+
+    // One log call, 256 bytes. Strings live in text, their arg holds offset << 16 | length.
+    struct Record {
+        std::uint64_t time = 0;          // ns since the epoch
+        const char* fmt = nullptr;
+        std::uint32_t thread = 0;
+        LogLevel level = LogLevel::info;
+        std::uint8_t argc = 0;
+        std::uint16_t textUsed = 0;
+        ArgType types[maxArgs];          // only the first argc are set, the call site
+        std::uint64_t args[maxArgs];     // skips zeroing the rest
+        char text[textBytes];
+    };
+
+    static_assert(sizeof(Record) == 256, "Logger: keep Record at four cache lines");
+
+    struct ThreadBuffer {
+        SpscRing<Record> ring;
+        std::uint32_t id;
+        std::atomic<bool> inUse{ true };             // false once its thread has ended
+        ThreadBuffer(std::size_t records, std::uint32_t i) : ring(records), id(i) {}
+    };
+
+    // One entry of a thread's "my buffer in logger #id" list, ids are never reused
+    struct Cached {
+        std::uint64_t logger = 0;
+        ThreadBuffer* buffer = nullptr;
+    };
+
+    static std::atomic<std::uint64_t>& nextId() {
+        static std::atomic<std::uint64_t> id{1};
+        return id;
+    }
+
+    // Ids of the loggers still alive, so a thread can forget the ones that are gone
+    struct LiveIds {
+        std::mutex lock;
+        std::vector<std::uint64_t> ids;
+    };
+    static LiveIds& live() {
+        static LiveIds l;
+        return l;
+    }
+
+    // A thread's list; gives its rings back when the thread ends. The live() lock keeps the
+    // logger from going away in between (its destructor takes the id out first).
+    struct CachedList {
+        std::vector<Cached> entries;
+        ~CachedList() {
+            LiveIds& l = live();
+            std::lock_guard<std::mutex> guard(l.lock);
+            for (const Cached& c : entries) {
+                if (std::find(l.ids.begin(), l.ids.end(), c.logger) != l.ids.end()) c.buffer->inUse.store(false, std::memory_order_release);
+            }
+        }
+    };
+
+    std::uint64_t id = nextId().fetch_add(1);
+    std::size_t perThread;
+    LogOverflow overflow;
+    std::chrono::milliseconds interval;
+    std::atomic<std::uint8_t> runtimeLevel{0};
+    std::atomic<std::uint64_t> dropCount{0};
+    std::atomic<bool> nudged{false};                  // a ring is half full, writer asked to come early
+
+    std::mutex lock;                                  // buffers, sinks, flush handshake
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    std::vector<Sink> sinks;
+    std::condition_variable wake;
+    std::condition_variable flushed;
+    std::uint64_t flushWanted = 0;
+    std::uint64_t flushDone = 0;
+    bool stopping = false;
+    std::uint64_t lastSecond = ~std::uint64_t(0);    // writer thread only
+    char secondText[80] = {};
+    std::thread writer;
+
+    // The calling thread's ring in this logger, one per (thread, logger) pair. The thread
+    // keeps a short list of them, so switching between loggers doesn't lose the ring.
+    // A ring given back by a thread that ended is reused before a new one is made.
+    ThreadBuffer& myBuffer() {
+        thread_local CachedList list;
+        std::vector<Cached>& cached = list.entries;
+        for (std::size_t i = 0; i < cached.size(); ++i) {
+            if (cached[i].logger != id) continue;
+            if (i > 0) std::swap(cached[i], cached[0]);   // the logger in use goes first
+            return *cached[0].buffer;
+        }
+
+        // First call from this thread: drop entries of loggers that no longer exist
+        if (cached.size() >= 8) {
+            LiveIds& l = live();
+            std::lock_guard<std::mutex> guard(l.lock);
+            std::erase_if(cached, [&](const Cached& c) { return std::find(l.ids.begin(), l.ids.end(), c.logger) == l.ids.end(); });
+        }
+        ThreadBuffer* b = nullptr;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            for (auto& tb : buffers) {
+                bool expected = false;
+                if (tb->inUse.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                    b = tb.get();
+                    break;
+                }
+            }
+            if (!b) {
+                buffers.push_back(std::make_unique<ThreadBuffer>(perThread, static_cast<std::uint32_t>(buffers.size())));
+                b = buffers.back().get();
+            }
+        }
+        cached.insert(cached.begin(), Cached{ id, b });
+        return *b;
+    }
+
+    // ---- call site side: copy the arguments raw ----
+
+    static void putText(Record& r, std::size_t i, std::string_view s) {
+        std::size_t room = textBytes - r.textUsed;
+        std::size_t n = std::min(s.size(), room);
+        std::memcpy(r.text + r.textUsed, s.data(), n);
+        if (n < s.size() && n >= 3) std::memcpy(r.text + r.textUsed + n - 3, "...", 3);
+        r.types[i] = ArgType::text;
+        r.args[i] = (static_cast<std::uint64_t>(r.textUsed) << 16) | n;
+        r.textUsed = static_cast<std::uint16_t>(r.textUsed + n);
+    }
+
+    template <typename T>
+    static void put(Record& r, std::size_t i, const T& v) {
+        using D = std::decay_t<T>;
+        if constexpr (std::is_same_v<D, bool>) {
+            r.types[i] = ArgType::boolean;
+            r.args[i] = v;
+        }
+        else if constexpr (std::is_same_v<D, char>) {
+            r.types[i] = ArgType::character;
+            r.args[i] = static_cast<unsigned char>(v);
+        }
+        else if constexpr (std::is_enum_v<D>) put(r, i, static_cast<std::underlying_type_t<D>>(v));
+        else if constexpr (std::is_integral_v<D> && std::is_signed_v<D>) {
+            r.types[i] = ArgType::i64;
+            r.args[i] = static_cast<std::uint64_t>(static_cast<std::int64_t>(v));
+        }
+        else if constexpr (std::is_integral_v<D>) {
+            r.types[i] = ArgType::u64;
+            r.args[i] = static_cast<std::uint64_t>(v);
+        }
+        else if constexpr (std::is_floating_point_v<D>) {
+            double d = static_cast<double>(v);
+            r.types[i] = ArgType::f64;
+            std::memcpy(&r.args[i], &d, sizeof(d));
+        }
+        else if constexpr (std::is_convertible_v<const T&, std::string_view>) putText(r, i, std::string_view(v));
+        else if constexpr (std::is_pointer_v<D>) {
+            r.types[i] = ArgType::pointer;
+            r.args[i] = reinterpret_cast<std::uintptr_t>(v);
+        }
+        else static_assert(std::is_arithmetic_v<D>, "Logger: argument type can't be logged");
+    }
+
+    template <typename... A>
+    void push(LogLevel level, const char* fmt, const A&... a) {
+        static_assert(sizeof...(A) <= maxArgs, "Logger: too many arguments");
+        if (static_cast<std::uint8_t>(level) < runtimeLevel.load(std::memory_order_relaxed)) return;
+        Record r;
+        r.time = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+        r.fmt = fmt;
+        r.level = level;
+        r.argc = static_cast<std::uint8_t>(sizeof...(A));
+        std::size_t i = 0;
+        (put(r, i++, a), ...);
+        ThreadBuffer& b = myBuffer();
+        r.thread = b.id;
+        if (b.ring.push(r)) {
+            // wake the writer early instead of letting the ring fill up before its next round
+            if (b.ring.size() * 2 >= b.ring.capacity() && !nudged.exchange(true, std::memory_order_relaxed)) wake.notify_one();
+            return;
+        }
+        if (overflow == LogOverflow::drop) {
+            dropCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        while (!b.ring.push(r)) std::this_thread::yield();
+    }
+
+    // ---- writer side ----
+
+    static void appendNumber(std::string& out, auto v) {
+        char buf[32];
+        auto res = std::to_chars(buf, buf + sizeof(buf), v);
+        out.append(buf, res.ptr);
+    }
+
+    static void appendArg(std::string& out, const Record& r, std::size_t i) {
+        std::uint64_t v = r.args[i];
+        switch (r.types[i]) {
+            case ArgType::i64: appendNumber(out, static_cast<std::int64_t>(v)); break;
+            case ArgType::u64: appendNumber(out, v); break;
+            case ArgType::f64: {
+                double d;
+                std::memcpy(&d, &v, sizeof(d));
+                appendNumber(out, d);
+                break;
+            }
+            case ArgType::boolean: out += v ? "true" : "false"; break;
+            case ArgType::character: out += static_cast<char>(v); break;
+            case ArgType::text: out.append(r.text + (v >> 16), v & 0xffff); break;
+            case ArgType::pointer: {
+                char buf[24];
+                auto res = std::to_chars(buf, buf + sizeof(buf), v, 16);
+                out += "0x";
+                out.append(buf, res.ptr);
+                break;
+            }
+        }
+    }
+
+    // "2024-05-01 12:00:00.123456" (UTC). The date part is only redone when the second changes.
+    void appendTime(std::string& out, std::uint64_t ns) {
+        std::uint64_t second = ns / 1000000000;
+        if (second != lastSecond) {
+            std::time_t secs = static_cast<std::time_t>(second);
+            std::tm tm{};
+#if defined(_WIN32)
+            gmtime_s(&tm, &secs);
+#else
+            gmtime_r(&secs, &tm);
+#endif
+            std::snprintf(secondText, sizeof(secondText), "%04d-%02d-%02d %02d:%02d:%02d.", tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday,
+                          tm.tm_hour, tm.tm_min, tm.tm_sec);
+            lastSecond = second;
+        }
+        out += secondText;
+        char micros[6];
+        for (std::uint64_t us = ns % 1000000000 / 1000, d = 6; d-- > 0; us /= 10) micros[d] = static_cast<char>('0' + us % 10);
+        out.append(micros, 6);
+    }
+
+    void format(std::string& out, const Record& r) {
+        static const char* names[] = { "TRACE", "DEBUG", "INFO ", "WARN ", "ERROR" };
+        appendTime(out, r.time);
+        out += ' ';
+        out += names[static_cast<std::size_t>(r.level)];
+        out += " [";
+        appendNumber(out, r.thread);
+        out += "] ";
+        std::size_t next = 0;
+        for (const char* p = r.fmt; *p; ++p) {
+            if (p[0] == '{' && p[1] == '}' && next < r.argc) {
+                appendArg(out, r, next++);
+                ++p;
+            }
+            else out += *p;
+        }
+        out += '\n';
+    }
+
+    // Takes what every ring held when it was looked at (records pushed meanwhile wait for the
+    // next round, so busy threads can't keep a flush waiting), writes it. Returns how many.
+    std::size_t drain(std::vector<Record>& batch, std::string& out) {
+        batch.clear();
+        std::size_t count;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            count = buffers.size();
+        }
+        for (std::size_t b = 0; b < count; ++b) {
+            ThreadBuffer* tb;
+            {
+                std::lock_guard<std::mutex> guard(lock);   // the vector may grow meanwhile
+                tb = buffers[b].get();
+            }
+            Record r;
+            for (std::size_t n = tb->ring.size(); n > 0 && tb->ring.pop(r); --n) batch.push_back(r);
+        }
+        if (batch.empty()) return 0;
+        std::stable_sort(batch.begin(), batch.end(), [](const Record& a, const Record& b) { return a.time < b.time; });
+        out.clear();
+        for (const Record& r : batch) format(out, r);
+        std::vector<Sink> current;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            current = sinks;
+        }
+        for (Sink& s : current) s(out);
+        return batch.size();
+    }
+
+    void writeLoop() {
+        std::vector<Record> batch;
+        std::string out;
+        while (true) {
+            std::uint64_t want;
+            bool stop;
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                wake.wait_for(guard, interval, [&] { return stopping || flushWanted != flushDone || nudged.load(std::memory_order_relaxed); });
+                nudged.store(false, std::memory_order_relaxed);
+                want = flushWanted;
+                stop = stopping;
+            }
+            drain(batch, out);
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                flushDone = want;
+            }
+            flushed.notify_all();
+            if (stop) return;
+        }
+    }
+
+public:
+    explicit Logger(std::size_t perThreadRecords = 1024, LogOverflow o = LogOverflow::drop,
+                    std::chrono::milliseconds drainEvery = std::chrono::milliseconds(2))
+        : perThread(perThreadRecords), overflow(o), interval(drainEvery) {
+        {
+            LiveIds& l = live();
+            std::lock_guard<std::mutex> guard(l.lock);
+            l.ids.push_back(id);
+        }
+        writer = std::thread([this] { writeLoop(); });
+    }
+    ~Logger() {
+        {
+            LiveIds& l = live();
+            std::lock_guard<std::mutex> guard(l.lock);
+            std::erase(l.ids, id);
+        }
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_all();
+        writer.join();
+    }
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    // Gets every batch of formatted lines
+    void addSink(Sink s) {
+        std::lock_guard<std::mutex> guard(lock);
+        sinks.push_back(std::move(s));
+    }
+
+    static Sink console(bool toStderr = false) {
+        std::FILE* f = toStderr ? stderr : stdout;
+        return [f](std::string_view s) {
+            std::fwrite(s.data(), 1, s.size(), f);
+            std::fflush(f);
+        };
+    }
+
+    // Appends to path (created if missing). An unopenable file gives a sink that drops everything.
+    static Sink file(const std::string& path) {
+        std::shared_ptr<std::FILE> f(std::fopen(path.c_str(), "ab"), [](std::FILE* p) {
+            if (p) std::fclose(p);
+        });
+        return [f](std::string_view s) {
+            if (!f) return;
+            std::fwrite(s.data(), 1, s.size(), f.get());
+            std::fflush(f.get());
+        };
+    }
+
+    // Everything below level is dropped at the call site (after the compile time filter)
+    void setLevel(LogLevel level) { runtimeLevel.store(static_cast<std::uint8_t>(level), std::memory_order_relaxed); }
+
+    template <LogLevel L, typename... A>
+    void log(const char* fmt, const A&... a) {
+        if constexpr (enabled(L)) push(L, fmt, a...);
+    }
+    template <typename... A> void trace(const char* fmt, const A&... a) { log<LogLevel::trace>(fmt, a...); }
+    template <typename... A> void debug(const char* fmt, const A&... a) { log<LogLevel::debug>(fmt, a...); }
+    template <typename... A> void info(const char* fmt, const A&... a) { log<LogLevel::info>(fmt, a...); }
+    template <typename... A> void warn(const char* fmt, const A&... a) { log<LogLevel::warn>(fmt, a...); }
+    template <typename... A> void error(const char* fmt, const A&... a) { log<LogLevel::error>(fmt, a...); }
+
+    // Blocks until everything logged before the call has gone to the sinks
+    void flush() {
+        std::unique_lock<std::mutex> guard(lock);
+        std::uint64_t ticket = ++flushWanted;
+        wake.notify_all();
+        flushed.wait(guard, [&] { return flushDone >= ticket; });
+    }
+
+    std::uint64_t dropped() const { return dropCount.load(std::memory_order_relaxed); }
+};
+
+// Same as log.info(...) etc., but below LOGGER_MIN_LEVEL the arguments aren't even evaluated
+#define LOGGER_AT(logger, level, ...) \
+    do { \
+        if constexpr (Logger::enabled(level)) (logger).log<level>(__VA_ARGS__); \
+    } while (0)
+#define LOG_TRACE(logger, ...) LOGGER_AT(logger, LogLevel::trace, __VA_ARGS__)
+#define LOG_DEBUG(logger, ...) LOGGER_AT(logger, LogLevel::debug, __VA_ARGS__)
+#define LOG_INFO(logger, ...) LOGGER_AT(logger, LogLevel::info, __VA_ARGS__)
+#define LOG_WARN(logger, ...) LOGGER_AT(logger, LogLevel::warn, __VA_ARGS__)
+#define LOG_ERROR(logger, ...) LOGGER_AT(logger, LogLevel::error, __VA_ARGS__)
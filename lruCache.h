@@ -0,0 +1,406 @@
+#pragma once
+#include <atomic>       // std::atomic, std::atomic_ref
+#include <bit>          // std::bit_ceil
+#include <cstddef>      // std::size_t
+#include <cstdint>
+#include <functional>   // std::hash, std::equal_to
+#include <memory>       // std::unique_ptr
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <utility>      // std::move
+#include <vector>
+#include "flatHashSet.h"
+#include "nodePool.h"
+// NOT USING NAMESPACE STD FOR MORE ROBUST CODE
+
+/*
+7. LRUCache (templated)
+    Use: Cache computed values (parsing, expensive transforms), from one thread (LRUCache)
+         or many (ShardedLRUCache).
+    Steps: get(key) finds the entry through a small hash index and marks it recently used →
+           put(key, val) reuses the least recently used entry when full (its key, value and
+           index slot get overwritten, nothing is freed or allocated).
+    Notes:
+        - Entries sit in a NodePool sized up front and link to each other by 32 bit index
+          (intrusive list: the prev/next links live inside the entry). The hash index is an
+          open addressing table of entry numbers with backward shift deletion, so there are no
+          tombstones and it never rehashes. Once full, get/put allocate nothing.
+        - Eviction::lru keeps an exact recency list: every hit moves the entry to the front.
+        - Eviction::clock approximates it: a hit only sets a "referenced" bit; eviction sweeps a
+          hand over the entries, clearing bits, and takes the first one without the bit. Hits
+          then write no links at all, which is what lets ShardedLRUCache serve them under a
+          shared (reader) lock.
+        - ShardedLRUCache splits the capacity over independent shards picked by hash, each with
+          its own lock on its own cache line, so threads mostly don't meet. get copies the
+          value out (a pointer would dangle once the lock is released).
+        - stats() counts hits, misses, inserts and evictions.
+        - Key and Value must be default constructible (the entries are preallocated).
+*/
+
+enum class Eviction { lru, clock };
+
+struct CacheStats {
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t inserts = 0;
+    std::uint64_t evictions = 0;
+
+    double hitRate() const { return hits + misses ? static_cast<double>(hits) / static_cast<double>(hits + misses) : 0.0; }
+    CacheStats& operator+=(const CacheStats& o) {
+        hits += o.hits;
+        misses += o.misses;
+        inserts += o.inserts;
+        evictions += o.evictions;
+        return *this;
+    }
+};
+
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Eq = std::equal_to<>>
+class LRUCache {
+private:
+    using Index = std::uint32_t;
+    static constexpr Index nil = static_cast<Index>(-1);
+
+    struct Entry {
+        Key key{};
+        Value value{};
+        std::size_t hash = 0;        // mixed, kept so the index never hashes a key twice
+        Index prev = nil;            // towards most recently used (lru only)
+        Index next = nil;            // towards least recently used (lru only)
+        std::uint8_t referenced = 0; // clock only, written through atomic_ref by shared readers
+        bool live = false;
+    };
+
+    NodePool<Entry> entries;
+    std::vector<Index> table;        // entry + 1, 0 = empty
+    std::size_t tableMask;
+    std::size_t cap;
+    std::size_t count = 0;
+    Index head = nil;                // most recently used
+    Index tail = nil;                // least recently used
+    std::size_t hand = 0;            // clock position in the entry array
+    Eviction policy;
+    Hash hasher;
+    Eq eq;
+
+    // Relaxed atomics: hits are counted by concurrent readers in clock mode
+    mutable std::atomic<std::uint64_t> hitCount{0};
+    mutable std::atomic<std::uint64_t> missCount{0};
+    std::uint64_t insertCount = 0;
+    std::uint64_t evictCount = 0;
+
+    std::size_t home(std::size_t h) const { return h & tableMask; }
+
+    // Table slot pointing at key, or the empty slot where it would go
+    template <typename K>
+    std::size_t slotOf(const K& key, std::size_t h) const {
+        std::size_t i = home(h);
+        while (table[i]) {
+            const Entry& e = entries[table[i] - 1];
+            if (e.hash == h && eq(e.key, key)) return i;
+            i = (i + 1) & tableMask;
+        }
+        return i;
+    }
+
+    // Linear probing without tombstones: pull later entries of the run back into the hole
+    void unindex(std::size_t i) {
+        for (std::size_t j = (i + 1) & tableMask; table[j]; j = (j + 1) & tableMask) {
+            std::size_t k = home(entries[table[j] - 1].hash);
+            // move j into i unless its home lies cyclically in (i, j]
+            bool stays = i <= j ? (i < k && k <= j) : (i < k || k <= j);
+            if (stays) continue;
+            table[i] = table[j];
+            i = j;
+        }
+        table[i] = 0;
+    }
+
+    void unlink(Index e) {
+        Entry& n = entries[e];
+        if (n.prev != nil) entries[n.prev].next = n.next;
+        else head = n.next;
+        if (n.next != nil) entries[n.next].prev = n.prev;
+        else tail = n.prev;
+        n.prev = n.next = nil;
+    }
+
+    void pushFront(Index e) {
+        entries[e].prev = nil;
+        entries[e].next = head;
+        if (head != nil) entries[head].prev = e;
+        head = e;
+        if (tail == nil) tail = e;
+    }
+
+    void touch(Index e) {
+        if (policy == Eviction::clock) std::atomic_ref<std::uint8_t>(entries[e].referenced).store(1, std::memory_order_relaxed);
+        else if (head != e) {
+            unlink(e);
+            pushFront(e);
+        }
+    }
+
+    // Entry to give up when full
+    Index victim() {
+        if (policy == Eviction::lru) return tail;
+        while (true) {
+            if (hand >= entries.slotCount()) hand = 0;
+            Entry& e = entries[static_cast<Index>(hand)];
+            if (e.live) {
+                std::atomic_ref<std::uint8_t> ref(e.referenced);
+                if (!ref.load(std::memory_order_relaxed)) return static_cast<Index>(hand++);
+                ref.store(0, std::memory_order_relaxed);
+            }
+            ++hand;
+        }
+    }
+
+    template <typename K>
+    Index findIndex(const K& key) const {
+        if (count == 0) return nil;
+        std::size_t i = slotOf(key, FlatHashSet<std::size_t>::mix(hasher(key)));
+        return table[i] ? table[i] - 1 : nil;
+    }
+
+public:
+    explicit LRUCache(std::size_t capacity, Eviction e = Eviction::lru, Hash h = {}, Eq q = {})
+        : cap(capacity < 1 ? 1 : capacity), policy(e), hasher(std::move(h)), eq(std::move(q)) {
+        entries.reserve(cap);
+        std::size_t t = std::bit_ceil(cap * 2);   // at most half full, probe runs stay short
+        table.assign(t < 16 ? 16 : t, 0);
+        tableMask = table.size() - 1;
+    }
+    LRUCache(const LRUCache&) = delete;
+    LRUCache& operator=(const LRUCache&) = delete;
+
+    // Value for key, or nullptr. Marks it recently used. The pointer is good until the next put/erase.
+    template <typename K>
+    Value* get(const K& key) {
+        Index e = findIndex(key);
+        if (e == nil) {
+            missCount.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        hitCount.fetch_add(1, std::memory_order_relaxed);
+        touch(e);
+        return &entries[e].value;
+    }
+
+    // Clock mode only: a hit that writes nothing but the referenced bit and the counters,
+    // so several threads may call it at once as long as nobody calls put/erase meanwhile.
+    template <typename K>
+    bool getShared(const K& key, Value& out) const {
+        Index e = findIndex(key);
+        if (e == nil) {
+            missCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        hitCount.fetch_add(1, std::memory_order_relaxed);
+        const Entry& n = entries[e];
+        std::atomic_ref<std::uint8_t>(const_cast<std::uint8_t&>(n.referenced)).store(1, std::memory_order_relaxed);
+        out = n.value;
+        return true;
+    }
+
+    // Lookup without touching recency or the counters
+    template <typename K>
+    bool contains(const K& key) const { return findIndex(key) != nil; }
+    template <typename K>
+    const Value* peek(const K& key) const {
+        Index e = findIndex(key);
+        return e == nil ? nullptr : &entries[e].value;
+    }
+
+    // Inserts or overwrites. Returns true if key was new.
+    bool put(Key key, Value value) {
+        std::size_t h = FlatHashSet<std::size_t>::mix(hasher(key));
+        std::size_t i = slotOf(key, h);
+        if (table[i]) {
+            Index e = table[i] - 1;
+            entries[e].value = std::move(value);
+            touch(e);
+            return false;
+        }
+        Index e;
+        if (count == cap) {
+            e = victim();
+            unindex(slotOf(entries[e].key, entries[e].hash));
+            if (policy == Eviction::lru) unlink(e);
+            ++evictCount;
+            i = slotOf(key, h);   // the backward shift may have moved the free slot
+        }
+        else {
+            e = entries.create();
+            ++count;
+        }
+        Entry& n = entries[e];
+        n.key = std::move(key);
+        n.value = std::move(value);
+        n.hash = h;
+        n.referenced = 0;
+        n.live = true;
+        if (policy == Eviction::lru) pushFront(e);
+        table[i] = e + 1;
+        ++insertCount;
+        return true;
+    }
+
+    // Cached value for key, or make() stored and returned
+    template <typename F>
+    Value& getOrPut(const Key& key, F&& make) {
+        if (Value* v = get(key)) return *v;
+        put(key, make());
+        return const_cast<Value&>(*peek(key));
+    }
+
+    template <typename K>
+    bool erase(const K& key) {
+        if (count == 0) return false;
+        std::size_t i = slotOf(key, FlatHashSet<std::size_t>::mix(hasher(key)));
+        if (!table[i]) return false;
+        Index e = table[i] - 1;
+        unindex(i);
+        if (policy == Eviction::lru) unlink(e);
+        Entry& n = entries[e];
+        n.key = Key{};
+        n.value = Value{};
+        n.live = false;
+        entries.destroy(e);
+        --count;
+        return true;
+    }
+
+    void clear() {
+        entries.clear();
+        entries.reserve(cap);
+        table.assign(table.size(), 0);
+        count = 0;
+        head = tail = nil;
+        hand = 0;
+    }
+
+    std::size_t size() const { return count; }
+    std::size_t capacity() const { return cap; }
+    bool empty() const { return count == 0; }
+    Eviction eviction() const { return policy; }
+
+    CacheStats stats() const {
+        return { hitCount.load(std::memory_order_relaxed), missCount.load(std::memory_order_relaxed), insertCount, evictCount };
+    }
+};
+
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Eq = std::equal_to<>>
+class ShardedLRUCache {
+private:
+    using Cache = LRUCache<Key, Value, Hash, Eq>;
+
+    struct alignas(64) Shard {
+        mutable std::shared_mutex lock;
+        Cache cache;
+        Shard(std::size_t capacity, Eviction e, const Hash& h, const Eq& q) : cache(capacity, e, h, q) {}
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::size_t shardMask;
+    Hash hasher;
+
+    // Top bits pick the shard, the caches index with the low bits of the same mix
+    template <typename K>
+    Shard& shardOf(const K& key) const {
+        std::size_t h = FlatHashSet<std::size_t>::mix(hasher(key));
+        return *shards[(h >> 48) & shardMask];
+    }
+
+public:
+    // shardCount 0 = 4 per hardware thread. Rounded up to a power of two; each shard gets
+    // capacity / shardCount entries (rounded up), so hot keys can't use the whole capacity.
+    explicit ShardedLRUCache(std::size_t capacity, std::size_t shardCount = 0, Eviction e = Eviction::lru, Hash h = {}, Eq q = {})
+        : hasher(h) {
+        if (shardCount == 0) shardCount = 4 * (std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1);
+        shardCount = std::bit_ceil(shardCount);
+        if (shardCount > 65536) shardCount = 65536;
+        shardMask = shardCount - 1;
+        std::size_t each = (capacity + shardCount - 1) / shardCount;
+        shards.reserve(shardCount);
+        for (std::size_t i = 0; i < shardCount; ++i) shards.push_back(std::make_unique<Shard>(each, e, h, q));
+    }
+
+    // Copies the value into out. Clock mode only takes the shard's reader lock.
+    template <typename K>
+    bool get(const K& key, Value& out) {
+        Shard& s = shardOf(key);
+        if (s.cache.eviction() == Eviction::clock) {
+            std::shared_lock<std::shared_mutex> guard(s.lock);
+            return s.cache.getShared(key, out);
+        }
+        std::unique_lock<std::shared_mutex> guard(s.lock);
+        Value* v = s.cache.get(key);
+        if (!v) return false;
+        out = *v;
+        return true;
+    }
+
+    bool put(Key key, Value value) {
+        Shard& s = shardOf(key);
+        std::unique_lock<std::shared_mutex> guard(s.lock);
+        return s.cache.put(std::move(key), std::move(value));
+    }
+
+    // Cached value, or make() stored and returned. make runs under the shard lock, keep it short
+    // or compute outside and put().
+    template <typename F>
+    Value getOrPut(const Key& key, F&& make) {
+        Value v;
+        if (get(key, v)) return v;
+        Shard& s = shardOf(key);
+        std::unique_lock<std::shared_mutex> guard(s.lock);
+        if (const Value* cached = s.cache.peek(key)) return *cached;   // another thread got there first
+        v = make();
+        s.cache.put(key, v);
+        return v;
+    }
+
+    template <typename K>
+    bool erase(const K& key) {
+        Shard& s = shardOf(key);
+        std::unique_lock<std::shared_mutex> guard(s.lock);
+        return s.cache.erase(key);
+    }
+
+    template <typename K>
+    bool contains(const K& key) const {
+        Shard& s = shardOf(key);
+        std::shared_lock<std::shared_mutex> guard(s.lock);
+        return s.cache.contains(key);
+    }
+
+    void clear() {
+        for (auto& s : shards) {
+            std::unique_lock<std::shared_mutex> guard(s->lock);
+            s->cache.clear();
+        }
+    }
+
+    // Sums over shards, approximate while other threads are writing
+    std::size_t size() const {
+        std::size_t n = 0;
+        for (auto& s : shards) {
+            std::shared_lock<std::shared_mutex> guard(s->lock);
+            n += s->cache.size();
+        }
+        return n;
+    }
+    std::size_t capacity() const { return shards.size() * shards[0]->cache.capacity(); }
+    std::size_t shardCount() const { return shards.size(); }
+
+    CacheStats stats() const {
+        CacheStats total;
+        for (auto& s : shards) {
+            std::shared_lock<std::shared_mutex> guard(s->lock);
+            total += s->cache.stats();
+        }
+        return total;
+    }
+};
@@ -0,0 +1,79 @@
+#pragma once
+#include <cstddef>      // std::size_t
+#include <cstdint>
+#include <utility>      // std::forward
+#include <vector>
+// NOT USING NAMESPACE STD FOR MORE ROBUST CODE
+
+/*
+NodePool (templated)
+    Use: Storage for tree/list nodes. Nodes sit next to each other in one array and refer
+         to each other by 32 bit index instead of by pointer.
+    Steps: create() hands out the next free slot (reusing released ones first) →
+           nodes link to each other with the returned Index → destroy() puts a slot on the
+           free list → clear() or the pool's destructor drops every node at once.
+    Notes:
+        - Index instead of pointer: half the size per link, and the links stay valid when the
+          array grows or the whole pool is copied/moved/written to disk.
+        - Several trees can share one pool (pass it to their constructor) and be thrown away
+          together with one clear(), which is O(1) for trivially destructible nodes.
+        - References from operator[] are invalidated by create() (the array may grow), indices are not.
+*/
+
+template <typename T>
+class NodePool {
+public:
+    using Index = std::uint32_t;
+    static constexpr Index nil = static_cast<Index>(-1);
+
+private:
+    std::vector<T> slots;
+    std::vector<Index> freeSlots;
+
+public:
+    NodePool() = default;
+    explicit NodePool(std::size_t expected) { slots.reserve(expected); }
+
+    template <typename... Args>
+    Index create(Args&&... args) {
+        if (!freeSlots.empty()) {
+            Index i = freeSlots.back();
+            freeSlots.pop_back();
+            slots[i] = T(std::forward<Args>(args)...);
+            return i;
+        }
+        slots.emplace_back(std::forward<Args>(args)...);
+        return static_cast<Index>(slots.size() - 1);
+    }
+
+    // count new slots in a row, all set to fill. Returns the first one.
+    // For bulk builds that want a whole tree in one contiguous block.
+    Index appendBlock(std::size_t count, const T& fill) {
+        std::size_t first = slots.size();
+        slots.resize(first + count, fill);
+        return static_cast<Index>(first);
+    }
+
+    // The slot goes back on the free list, the next create() reuses it
+    void destroy(Index i) { freeSlots.push_back(i); }
+
+    T& operator[](Index i) { return slots[i]; }
+    const T& operator[](Index i) const { return slots[i]; }
+
+    // Drops every node at once (no per node work for plain structs)
+    void clear() {
+        slots.clear();
+        freeSlots.clear();
+    }
+
+    void reserve(std::size_t n) { slots.reserve(n); }
+
+    std::size_t size() const { return slots.size() - freeSlots.size(); }   // live nodes
+    std::size_t capacity() const { return slots.capacity(); }
+    std::size_t bytes() const { return slots.capacity() * sizeof(T) + freeSlots.capacity() * sizeof(Index); }
+
+    // Raw slot array, for code that walks or saves every slot
+    T* data() { return slots.data(); }
+    const T* data() const { return slots.data(); }
+    std::size_t slotCount() const { return slots.size(); }
+};
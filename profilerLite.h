@@ -0,0 +1,511 @@
+#pragma once
+#include <algorithm>    // std::sort, std::min, std::max
+#include <atomic>
+#include <bit>          // std::bit_width
+#include <chrono>
+#include <cstddef>      // std::size_t
+#include <cstdint>
+#include <cstdio>       // std::FILE, std::fopen, std::snprintf
+#include <memory>       // std::unique_ptr
+#include <mutex>
+#include <string>
+#include <vector>
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <x86intrin.h>  // __rdtsc
+#endif
+// NOT USING NAMESPACE STD FOR MORE ROBUST CODE
+
+/*
+27. Timer / ProfilerLite
+    Use: Find out where the time goes in a running program, cheap enough to leave on.
+    Steps: PROFILE_SCOPE("parse") at the top of a block → the scope reads the clock on the way
+           in and out → adds the time to the calling thread's own table for that label (count,
+           total, min, max, a log scale histogram), no lock and nothing shared → report() /
+           snapshot() merge all threads on demand → writeChromeTrace(path) dumps the single
+           scopes for chrome://tracing or ui.perfetto.dev.
+    Notes:
+        - Labels are keyed by their address, so they must be string literals (or outlive the
+          program). The same text from two places still ends up in one line of the report.
+        - The clock is the TSC on x86-64 (converted to ns against steady_clock when a report
+          is made) and steady_clock (CLOCK_MONOTONIC) everywhere else. PROFILER_TSC=0 forces
+          steady_clock, for machines whose TSC is not invariant.
+        - PROFILER_ENABLED=0 (define it before including) turns PROFILE_SCOPE and the probes
+          into nothing. setEnabled(false) switches scopes off at run time, they then cost one
+          relaxed load.
+        - PROFILER_PROBES=1 compiles in the probes inside Sorter and Search: time per phase
+          plus how many comparisons, swaps and allocations each phase did. They are off by
+          default because counting every comparison slows the sorts down.
+        - Nested scopes are inclusive: an outer scope's time and probe counts include its
+          inner scopes.
+        - Percentiles come from the histogram (4 buckets per power of two), so they are
+          within ~12% of the real value.
+        - Tracing (startTrace) keeps up to eventsPerThread scopes per thread and drops the rest.
+        - A thread's table outlives the thread and is handed to the next new thread, so
+          short lived threads don't pile up memory and nothing they measured is lost.
+        - reset() is meant for quiet moments. Scopes that are open while it runs may be
+          counted partly.
+*/
+
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED 1
+#endif
+
+#ifndef PROFILER_PROBES
+#define PROFILER_PROBES 0
+#endif
+
+#ifndef PROFILER_TSC
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define PROFILER_TSC 1
+#else
+#define PROFILER_TSC 0
+#endif
+#endif
+
+// Plain stopwatch for one off measurements
+class Timer {
+private:
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point start = Clock::now();
+
+public:
+    void restart() { start = Clock::now(); }
+    std::uint64_t ns() const {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+    }
+    double ms() const { return static_cast<double>(ns()) / 1e6; }
+    double seconds() const { return static_cast<double>(ns()) / 1e9; }
+};
+
+// One label merged over all threads, times in ns
+struct ProfileStat {
+    std::string label;
+    std::uint64_t calls = 0;
+    double total = 0, min = 0, max = 0, mean = 0;
+    double p50 = 0, p90 = 0, p99 = 0;
+    std::uint64_t comparisons = 0, swaps = 0, allocations = 0;
+};
+
+class ProfilerLite {
+public:
+    static constexpr bool compiled = PROFILER_ENABLED != 0;
+    static constexpr bool probes = compiled && PROFILER_PROBES != 0;
+    static constexpr std::size_t maxLabels = 256;   // per thread, more are counted in lost()
+    static constexpr std::size_t histBuckets = 188; // 4 per power of two up to 2^48 ticks
+
+    // What the probes count. Only ever touched by the thread that owns it.
+    struct Counters {
+        std::uint64_t comparisons = 0;
+        std::uint64_t swaps = 0;
+        std::uint64_t allocations = 0;
+    };
+
+private:
+    // Owner stores with load + store (one writer, no locked instructions), report() loads
+    struct Stat {
+        std::atomic<std::uint64_t> calls{ 0 }, total{ 0 }, min{ UINT64_MAX }, max{ 0 };
+        std::atomic<std::uint64_t> comparisons{ 0 }, swaps{ 0 }, allocations{ 0 };
+        std::atomic<std::uint64_t> hist[histBuckets] = {};
+    };
+
+    struct Event {
+        const char* label;
+        std::uint64_t start, ticks;
+        Counters counters;
+    };
+
+    struct ThreadState {
+        std::atomic<const char*> keys[maxLabels] = {};
+        std::atomic<Stat*> stats[maxLabels] = {};
+        std::vector<std::unique_ptr<Stat>> owned;      // owner thread only
+        std::atomic<Event*> events{ nullptr };
+        std::unique_ptr<Event[]> eventStore;
+        std::size_t eventCapacity = 0;
+        std::atomic<std::size_t> eventCount{ 0 };
+        std::atomic<std::uint64_t> lost{ 0 };
+        std::atomic<bool> inUse{ true };
+        std::uint32_t id = 0;
+        Counters counters;
+    };
+
+    struct Registry {
+        std::mutex lock;
+        std::vector<std::unique_ptr<ThreadState>> threads;
+        std::atomic<bool> enabled{ true };
+        std::atomic<bool> tracing{ false };
+        std::atomic<std::size_t> eventsPerThread{ 0 };
+        std::uint64_t baseTicks = now();
+        std::chrono::steady_clock::time_point baseTime = std::chrono::steady_clock::now();
+    };
+
+    static Registry& registry() {
+        static Registry r;
+        return r;
+    }
+
+    // Gives the thread's table back when the thread ends
+    struct Holder {
+        ThreadState* state = nullptr;
+        ~Holder() {
+            if (state) state->inUse.store(false, std::memory_order_release);
+        }
+    };
+
+    static ThreadState* attach() {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> guard(r.lock);
+        for (auto& t : r.threads) {
+            bool expected = false;
+            if (t->inUse.compare_exchange_strong(expected, true, std::memory_order_acquire)) return t.get();
+        }
+        r.threads.push_back(std::make_unique<ThreadState>());
+        r.threads.back()->id = static_cast<std::uint32_t>(r.threads.size() - 1);
+        return r.threads.back().get();
+    }
+
+    // The calling thread's table (registered on first use)
+    static ThreadState& local() {
+        thread_local Holder holder;
+        if (!holder.state) holder.state = attach();
+        return *holder.state;
+    }
+
+    static void add(std::atomic<std::uint64_t>& a, std::uint64_t v) {
+        a.store(a.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+    }
+
+    // 0..3 exact, then 4 buckets per power of two
+    static std::size_t bucket(std::uint64_t ticks) {
+        if (ticks < 4) return static_cast<std::size_t>(ticks);
+        std::size_t b = static_cast<std::size_t>(std::bit_width(ticks)) - 1;
+        std::size_t i = (b - 1) * 4 + static_cast<std::size_t>((ticks >> (b - 2)) & 3);
+        return i < histBuckets ? i : histBuckets - 1;
+    }
+    // Middle of bucket i, in ticks
+    static double bucketMid(std::size_t i) {
+        if (i < 4) return static_cast<double>(i);
+        std::size_t b = i / 4 + 1;
+        double width = static_cast<double>(std::uint64_t(1) << (b - 2));
+        return static_cast<double>(4 + i % 4) * width + width / 2;
+    }
+
+    static Stat* find(ThreadState& t, const char* label) {
+        std::size_t h = (reinterpret_cast<std::uintptr_t>(label) >> 3) * 0x9E3779B97F4A7C15ull >> 56;
+        for (std::size_t probe = 0; probe < maxLabels; ++probe) {
+            std::size_t i = (h + probe) & (maxLabels - 1);
+            const char* k = t.keys[i].load(std::memory_order_relaxed);
+            if (k == label) return t.stats[i].load(std::memory_order_relaxed);
+            if (k == nullptr) {
+                t.owned.push_back(std::make_unique<Stat>());
+                t.stats[i].store(t.owned.back().get(), std::memory_order_relaxed);
+                t.keys[i].store(label, std::memory_order_release);   // readers see the stat first
+                return t.owned.back().get();
+            }
+        }
+        return nullptr;
+    }
+
+    // ns per tick, measured over everything since the first use (at least 2 ms)
+    static double nsPerTick() {
+        if constexpr (!PROFILER_TSC) return 1.0;
+        Registry& r = registry();
+        std::uint64_t ticks;
+        std::chrono::steady_clock::time_point t;
+        do {
+            ticks = now();
+            t = std::chrono::steady_clock::now();
+        } while (t - r.baseTime < std::chrono::milliseconds(2));
+        double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(t - r.baseTime).count());
+        return ticks > r.baseTicks ? ns / static_cast<double>(ticks - r.baseTicks) : 1.0;
+    }
+
+    static void appendEscaped(std::string& out, const char* s) {
+        for (; *s; ++s) {
+            unsigned char c = static_cast<unsigned char>(*s);
+            if (c == '"' || c == '\\') {
+                out += '\\';
+                out += static_cast<char>(c);
+            }
+            else if (c < 0x20) {
+                char buf[8];
+                std::snprintf(buf, sizeof buf, "\\u%04x", c);
+                out += buf;
+            }
+            else out += static_cast<char>(c);
+        }
+    }
+
+public:
+    // Raw clock, in ticks (TSC cycles or ns)
+    static std::uint64_t now() {
+#if PROFILER_TSC
+        return __rdtsc();
+#else
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    static void setEnabled(bool on) { registry().enabled.store(on, std::memory_order_relaxed); }
+    static bool enabled() { return compiled && registry().enabled.load(std::memory_order_relaxed); }
+
+    // Probe counters of the calling thread, scopes take the difference
+    static Counters& counters() { return local().counters; }
+
+    // Comparator that counts its calls into counters().comparisons
+    template <typename Less>
+    struct CountingLess {
+        Less& less;
+        template <typename A, typename B>
+        bool operator()(const A& a, const B& b) {
+            ++counters().comparisons;
+            return less(a, b);
+        }
+    };
+
+    // What the comparison engines get handed: less itself, or with PROFILER_PROBES a
+    // CountingLess around it. auto&& cmp = ProfilerLite::probed(less);
+    template <typename Less>
+    static decltype(auto) probed(Less& less) {
+        if constexpr (probes) return CountingLess<Less>{ less };
+        else return (less);
+    }
+
+    // Adds one measurement to label. ProfileScope calls this, it can be fed by hand too.
+    static void record(const char* label, std::uint64_t start, std::uint64_t ticks) { record(label, start, ticks, Counters{}); }
+    static void record(const char* label, std::uint64_t start, std::uint64_t ticks, const Counters& delta) {
+        ThreadState& t = local();
+        Stat* s = find(t, label);
+        if (!s) {
+            add(t.lost, 1);
+            return;
+        }
+        add(s->calls, 1);
+        add(s->total, ticks);
+        if (ticks < s->min.load(std::memory_order_relaxed)) s->min.store(ticks, std::memory_order_relaxed);
+        if (ticks > s->max.load(std::memory_order_relaxed)) s->max.store(ticks, std::memory_order_relaxed);
+        add(s->hist[bucket(ticks)], 1);
+        if (delta.comparisons) add(s->comparisons, delta.comparisons);
+        if (delta.swaps) add(s->swaps, delta.swaps);
+        if (delta.allocations) add(s->allocations, delta.allocations);
+
+        Registry& r = registry();
+        if (!r.tracing.load(std::memory_order_relaxed)) return;
+        Event* ev = t.events.load(std::memory_order_relaxed);
+        if (!ev) {
+            t.eventCapacity = r.eventsPerThread.load(std::memory_order_relaxed);
+            t.eventStore.reset(new Event[t.eventCapacity]);
+            ev = t.eventStore.get();
+            t.events.store(ev, std::memory_order_release);
+        }
+        std::size_t n = t.eventCount.load(std::memory_order_relaxed);
+        if (n >= t.eventCapacity) {
+            add(t.lost, 1);
+            return;
+        }
+        ev[n] = { label, start, ticks, delta };
+        t.eventCount.store(n + 1, std::memory_order_release);
+    }
+
+    // Starts keeping single scopes for writeChromeTrace. The buffer size is fixed by the first call.
+    static void startTrace(std::size_t eventsPerThread = std::size_t(1) << 16) {
+        Registry& r = registry();
+        std::size_t zero = 0;
+        r.eventsPerThread.compare_exchange_strong(zero, std::max<std::size_t>(1, eventsPerThread));
+        r.tracing.store(true, std::memory_order_relaxed);
+    }
+    static void stopTrace() { registry().tracing.store(false, std::memory_order_relaxed); }
+
+    // Scopes that found no room (label table or trace buffer full)
+    static std::uint64_t lost() {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> guard(r.lock);
+        std::uint64_t n = 0;
+        for (auto& t : r.threads) n += t->lost.load(std::memory_order_relaxed);
+        return n;
+    }
+
+    // All labels merged over all threads, biggest total first
+    static std::vector<ProfileStat> snapshot() {
+        std::vector<ProfileStat> out;
+        std::vector<std::vector<std::uint64_t>> hists;
+        std::vector<std::uint64_t> mins;
+        double scale = nsPerTick();
+
+        Registry& r = registry();
+        std::lock_guard<std::mutex> guard(r.lock);
+        for (auto& t : r.threads) {
+            for (std::size_t i = 0; i < maxLabels; ++i) {
+                const char* label = t->keys[i].load(std::memory_order_acquire);
+                if (!label) continue;
+                const Stat& s = *t->stats[i].load(std::memory_order_relaxed);
+                std::uint64_t calls = s.calls.load(std::memory_order_relaxed);
+                if (calls == 0) continue;
+
+                std::size_t k = 0;
+                while (k < out.size() && out[k].label != label) ++k;
+                if (k == out.size()) {
+                    out.emplace_back();
+                    out.back().label = label;
+                    hists.emplace_back(histBuckets, 0);
+                    mins.push_back(UINT64_MAX);
+                }
+                ProfileStat& p = out[k];
+                p.calls += calls;
+                p.total += static_cast<double>(s.total.load(std::memory_order_relaxed));
+                mins[k] = std::min(mins[k], s.min.load(std::memory_order_relaxed));
+                p.max = std::max(p.max, static_cast<double>(s.max.load(std::memory_order_relaxed)));
+                p.comparisons += s.comparisons.load(std::memory_order_relaxed);
+                p.swaps += s.swaps.load(std::memory_order_relaxed);
+                p.allocations += s.allocations.load(std::memory_order_relaxed);
+                for (std::size_t b = 0; b < histBuckets; ++b) hists[k][b] += s.hist[b].load(std::memory_order_relaxed);
+            }
+        }
+
+        for (std::size_t k = 0; k < out.size(); ++k) {
+            ProfileStat& p = out[k];
+            p.min = static_cast<double>(mins[k]);
+            auto percentile = [&](double q) {
+                std::uint64_t seen = 0, target = static_cast<std::uint64_t>(q * static_cast<double>(p.calls - 1)) + 1;
+                for (std::size_t b = 0; b < histBuckets; ++b) {
+                    seen += hists[k][b];
+                    if (seen >= target) return std::clamp(bucketMid(b), p.min, p.max) * scale;
+                }
+                return p.max * scale;
+            };
+            p.p50 = percentile(0.5);
+            p.p90 = percentile(0.9);
+            p.p99 = percentile(0.99);
+            p.total *= scale;
+            p.min *= scale;
+            p.max *= scale;
+            p.mean = p.total / static_cast<double>(p.calls);
+        }
+        std::sort(out.begin(), out.end(), [](const ProfileStat& a, const ProfileStat& b) { return a.total > b.total; });
+        return out;
+    }
+
+    // snapshot() as a text table
+    static std::string report() {
+        std::string out;
+        char line[320];
+        std::snprintf(line, sizeof line, "%-32s %10s %11s %10s %10s %10s %10s %10s %12s %10s %8s\n", "label", "calls", "total ms",
+                      "mean ns", "p50 ns", "p90 ns", "p99 ns", "max ns", "comparisons", "swaps", "allocs");
+        out += line;
+        for (const ProfileStat& p : snapshot()) {
+            std::snprintf(line, sizeof line, "%-32s %10llu %11.3f %10.0f %10.0f %10.0f %10.0f %10.0f %12llu %10llu %8llu\n",
+                          p.label.c_str(), static_cast<unsigned long long>(p.calls), p.total / 1e6, p.mean, p.p50, p.p90, p.p99,
+                          p.max, static_cast<unsigned long long>(p.comparisons), static_cast<unsigned long long>(p.swaps),
+                          static_cast<unsigned long long>(p.allocations));
+            out += line;
+        }
+        return out;
+    }
+
+    // Chrome trace event format ("X" events, ts/dur in us). false if the file can't be written.
+    static bool writeChromeTrace(const std::string& path) {
+        double scale = nsPerTick() / 1e3;
+        Registry& r = registry();
+        std::string json = "{\"traceEvents\":[\n";
+        bool first = true;
+        char num[160];
+        {
+            std::lock_guard<std::mutex> guard(r.lock);
+            for (auto& t : r.threads) {
+                std::size_t n = t->eventCount.load(std::memory_order_acquire);
+                const Event* ev = t->events.load(std::memory_order_acquire);
+                for (std::size_t i = 0; i < n; ++i) {
+                    const Event& e = ev[i];
+                    double ts = static_cast<double>(static_cast<std::int64_t>(e.start - r.baseTicks)) * scale;
+                    json += first ? "{\"name\":\"" : ",\n{\"name\":\"";
+                    first = false;
+                    appendEscaped(json, e.label);
+                    std::snprintf(num, sizeof num, "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f", t->id, ts,
+                                  static_cast<double>(e.ticks) * scale);
+                    json += num;
+                    if (e.counters.comparisons || e.counters.swaps || e.counters.allocations) {
+                        std::snprintf(num, sizeof num, ",\"args\":{\"comparisons\":%llu,\"swaps\":%llu,\"allocations\":%llu}",
+                                      static_cast<unsigned long long>(e.counters.comparisons),
+                                      static_cast<unsigned long long>(e.counters.swaps),
+                                      static_cast<unsigned long long>(e.counters.allocations));
+                        json += num;
+                    }
+                    json += '}';
+                }
+            }
+        }
+        json += "\n],\"displayTimeUnit\":\"ns\"}\n";
+
+        std::FILE* f = std::fopen(path.c_str(), "wb");
+        if (!f) return false;
+        bool ok = std::fwrite(json.data(), 1, json.size(), f) == json.size();
+        return std::fclose(f) == 0 && ok;
+    }
+
+    // Zeroes every table and the trace buffers
+    static void reset() {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> guard(r.lock);
+        for (auto& t : r.threads) {
+            for (std::size_t i = 0; i < maxLabels; ++i) {
+                if (!t->keys[i].load(std::memory_order_acquire)) continue;
+                Stat& s = *t->stats[i].load(std::memory_order_relaxed);
+                for (auto* a : { &s.calls, &s.total, &s.max, &s.comparisons, &s.swaps, &s.allocations }) a->store(0, std::memory_order_relaxed);
+                s.min.store(UINT64_MAX, std::memory_order_relaxed);
+                for (auto& h : s.hist) h.store(0, std::memory_order_relaxed);
+            }
+            t->eventCount.store(0, std::memory_order_relaxed);
+            t->lost.store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+// Times its own lifetime under label (and the probe counts of that time, with PROFILER_PROBES)
+class ProfileScope {
+#if PROFILER_ENABLED
+private:
+    const char* label;
+    std::uint64_t start = 0;
+    ProfilerLite::Counters before;
+
+public:
+    explicit ProfileScope(const char* l) : label(ProfilerLite::enabled() ? l : nullptr) {
+        if (!label) return;
+        if constexpr (ProfilerLite::probes) before = ProfilerLite::counters();
+        start = ProfilerLite::now();
+    }
+    ~ProfileScope() {
+        if (!label) return;
+        std::uint64_t end = ProfilerLite::now();
+        ProfilerLite::Counters delta;
+        if constexpr (ProfilerLite::probes) {
+            const ProfilerLite::Counters& c = ProfilerLite::counters();
+            delta = { c.comparisons - before.comparisons, c.swaps - before.swaps, c.allocations - before.allocations };
+        }
+        ProfilerLite::record(label, start, end - start, delta);
+    }
+#else
+public:
+    explicit ProfileScope(const char*) {}
+#endif
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+#define PROFILER_CONCAT_(a, b) a##b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_(a, b)
+
+#if PROFILER_ENABLED
+#define PROFILE_SCOPE(label) ProfileScope PROFILER_CONCAT(profileScope_, __LINE__)(label)
+#else
+#define PROFILE_SCOPE(label) ((void)0)
+#endif
+
+// Probes used inside the library (Sorter, Search), compiled in with PROFILER_PROBES=1
+#if PROFILER_ENABLED && PROFILER_PROBES
+#define PROFILE_PROBE_SCOPE(label) ProfileScope PROFILER_CONCAT(probeScope_, __LINE__)(label)
+#define PROFILE_PROBE_COUNT(field, n) (ProfilerLite::counters().field += (n))
+#else
+#define PROFILE_PROBE_SCOPE(label) ((void)0)
+#define PROFILE_PROBE_COUNT(field, n) ((void)0)
+#endif
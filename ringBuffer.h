@@ -0,0 +1,360 @@
+#pragma once
+#include <algorithm>    // std::min
+#include <atomic>
+#include <bit>          // std::bit_ceil
+#include <cstddef>      // std::size_t
+#include <cstdint>
+#include <memory>       // std::unique_ptr
+#include <span>
+#include <thread>       // std::this_thread::yield
+#include <utility>      // std::move
+#include <vector>
+// NOT USING NAMESPACE STD FOR MORE ROBUST CODE
+
+/*
+6. RingBuffer (templated)
+    Use: Fixed-capacity buffer for streaming inputs (logs, sensor samples) and for handing
+         items from ingest threads to worker threads.
+    Steps: Allocate capacity (rounded up to a power of two) → push at the tail, pop at the
+           head, both counters only ever grow and slot = counter & (capacity - 1) →
+           when full either reject the push or drop the oldest item (RingPolicy).
+    Notes:
+        - Three versions, same push / pop / pushBatch / popBatch calls:
+            RingBuffer<T>  one thread, reject or overwrite-oldest, plus peek / back / [i].
+            SpscRing<T>    one producer thread + one consumer thread, lock-free. Each side
+                           keeps its own copy of the other side's counter and only re-reads
+                           the shared one when its copy says full/empty.
+            MpmcRing<T>    any number of producers and consumers, lock-free (per slot sequence
+                           numbers, Vyukov style), reject or overwrite-oldest.
+        - Head and tail sit on their own cache lines, so producers and consumers don't keep
+          stealing the same line from each other (false sharing).
+        - Batch calls move a whole span with one counter update; that's where the ring gets
+          its throughput, one atomic per batch instead of per item.
+        - SpscRing only rejects when full: dropping the oldest item means the producer pops,
+          and then there are two consumers. Use MpmcRing with RingPolicy::overwrite for that.
+        - T must be default constructible and movable (slots are preallocated).
+*/
+
+enum class RingPolicy { reject, overwrite };
+
+// ================= Single thread =================
+
+template <typename T>
+class RingBuffer {
+private:
+    std::vector<T> slots;
+    std::size_t mask;
+    std::uint64_t head = 0;     // next to pop
+    std::uint64_t tail = 0;     // next to push
+    std::uint64_t dropCount = 0;
+    RingPolicy policy;
+
+    T& slot(std::uint64_t i) { return slots[static_cast<std::size_t>(i) & mask]; }
+    const T& slot(std::uint64_t i) const { return slots[static_cast<std::size_t>(i) & mask]; }
+
+public:
+    explicit RingBuffer(std::size_t capacity, RingPolicy p = RingPolicy::reject)
+        : slots(std::bit_ceil(capacity < 1 ? std::size_t(1) : capacity)), mask(slots.size() - 1), policy(p) {}
+
+    // false if full and the policy is reject. With overwrite the oldest item is dropped.
+    bool push(T value) {
+        if (tail - head == slots.size()) {
+            if (policy == RingPolicy::reject) return false;
+            ++head;
+            ++dropCount;
+        }
+        slot(tail++) = std::move(value);
+        return true;
+    }
+
+    bool pop(T& out) {
+        if (head == tail) return false;
+        out = std::move(slot(head++));
+        return true;
+    }
+
+    // Pushes as many of values as fit (all of them with overwrite, the last capacity()
+    // survive). Returns how many went in.
+    std::size_t pushBatch(std::span<const T> values) {
+        std::size_t n = values.size();
+        if (policy == RingPolicy::reject) n = std::min(n, slots.size() - size());
+        else if (n > slots.size()) {
+            // only the newest capacity() items can survive, skip writing the rest
+            std::size_t skip = n - slots.size();
+            dropCount += skip + size();
+            head = tail = tail + skip;
+            values = values.subspan(skip);
+        }
+        std::size_t room = slots.size() - size();
+        if (values.size() > room && policy == RingPolicy::overwrite) {
+            std::size_t over = values.size() - room;
+            head += over;
+            dropCount += over;
+        }
+        std::size_t todo = std::min(values.size(), n);
+        for (std::size_t i = 0; i < todo; ++i) slot(tail++) = values[i];
+        return n;
+    }
+
+    // Pops up to out.size() items, oldest first. Returns how many.
+    std::size_t popBatch(std::span<T> out) {
+        std::size_t n = std::min<std::size_t>(out.size(), static_cast<std::size_t>(tail - head));
+        for (std::size_t i = 0; i < n; ++i) out[i] = std::move(slot(head++));
+        return n;
+    }
+
+    // Oldest / newest item, ring must not be empty
+    T& peek() { return slot(head); }
+    const T& peek() const { return slot(head); }
+    T& back() { return slot(tail - 1); }
+    const T& back() const { return slot(tail - 1); }
+    // i-th oldest item
+    T& operator[](std::size_t i) { return slot(head + i); }
+    const T& operator[](std::size_t i) const { return slot(head + i); }
+
+    void clear() { head = tail; }
+    std::size_t size() const { return static_cast<std::size_t>(tail - head); }
+    std::size_t capacity() const { return slots.size(); }
+    bool empty() const { return head == tail; }
+    bool full() const { return size() == slots.size(); }
+    std::uint64_t dropped() const { return dropCount; }   // items lost to overwrite
+};
+
+// ================= One producer, one consumer =================
+
+template <typename T>
+class SpscRing {
+private:
+    // Producer's line: its counter and its copy of the consumer's
+    struct alignas(64) ProducerSide {
+        std::atomic<std::uint64_t> tail{0};
+        std::uint64_t headCache = 0;
+    };
+    struct alignas(64) ConsumerSide {
+        std::atomic<std::uint64_t> head{0};
+        std::uint64_t tailCache = 0;
+    };
+
+    ProducerSide prod;
+    ConsumerSide cons;
+    std::vector<T> slots;
+    std::size_t mask;
+
+    T& slot(std::uint64_t i) { return slots[static_cast<std::size_t>(i) & mask]; }
+
+    // Free slots as the producer sees them, re-reading head only when the cached one says full
+    std::size_t freeSlots(std::uint64_t t, std::size_t want) {
+        std::size_t free = slots.size() - static_cast<std::size_t>(t - prod.headCache);
+        if (free < want) {
+            prod.headCache = cons.head.load(std::memory_order_acquire);
+            free = slots.size() - static_cast<std::size_t>(t - prod.headCache);
+        }
+        return free;
+    }
+    std::size_t readySlots(std::uint64_t h, std::size_t want) {
+        std::size_t ready = static_cast<std::size_t>(cons.tailCache - h);
+        if (ready < want) {
+            cons.tailCache = prod.tail.load(std::memory_order_acquire);
+            ready = static_cast<std::size_t>(cons.tailCache - h);
+        }
+        return ready;
+    }
+
+public:
+    explicit SpscRing(std::size_t capacity) : slots(std::bit_ceil(capacity < 1 ? std::size_t(1) : capacity)), mask(slots.size() - 1) {}
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // Producer thread only. false if full.
+    bool push(T value) {
+        std::uint64_t t = prod.tail.load(std::memory_order_relaxed);
+        if (freeSlots(t, 1) == 0) return false;
+        slot(t) = std::move(value);
+        prod.tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Producer thread only. Pushes what fits, returns how many.
+    std::size_t pushBatch(std::span<const T> values) {
+        std::uint64_t t = prod.tail.load(std::memory_order_relaxed);
+        std::size_t n = std::min(values.size(), freeSlots(t, values.size()));
+        for (std::size_t i = 0; i < n; ++i) slot(t + i) = values[i];
+        prod.tail.store(t + n, std::memory_order_release);
+        return n;
+    }
+
+    // Consumer thread only. false if empty.
+    bool pop(T& out) {
+        std::uint64_t h = cons.head.load(std::memory_order_relaxed);
+        if (readySlots(h, 1) == 0) return false;
+        out = std::move(slot(h));
+        cons.head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer thread only. Pops up to out.size(), returns how many.
+    std::size_t popBatch(std::span<T> out) {
+        std::uint64_t h = cons.head.load(std::memory_order_relaxed);
+        std::size_t n = std::min(out.size(), readySlots(h, out.size()));
+        for (std::size_t i = 0; i < n; ++i) out[i] = std::move(slot(h + i));
+        cons.head.store(h + n, std::memory_order_release);
+        return n;
+    }
+
+    // Approximate while the other side is running
+    std::size_t size() const {
+        return static_cast<std::size_t>(prod.tail.load(std::memory_order_acquire) - cons.head.load(std::memory_order_acquire));
+    }
+    std::size_t capacity() const { return slots.size(); }
+    bool empty() const { return size() == 0; }
+};
+
+// ================= Many producers, many consumers =================
+
+template <typename T>
+class MpmcRing {
+private:
+    // seq says what the slot is waiting for: seq == pos, free for the push of pos;
+    // seq == pos + 1, holds the item of pos for its pop. A pop sets it to pos + capacity.
+    struct Cell {
+        std::atomic<std::uint64_t> seq;
+        T value;
+    };
+
+    struct alignas(64) Counter {
+        std::atomic<std::uint64_t> pos{0};
+    };
+
+    Counter enqueue;
+    Counter dequeue;
+    std::unique_ptr<Cell[]> cells;
+    std::size_t cap;
+    std::size_t mask;
+    RingPolicy policy;
+    std::atomic<std::uint64_t> dropCount{0};
+
+    Cell& cell(std::uint64_t pos) { return cells[static_cast<std::size_t>(pos) & mask]; }
+
+    bool tryPush(T& value) {
+        std::uint64_t pos = enqueue.pos.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& c = cell(pos);
+            std::int64_t diff = static_cast<std::int64_t>(c.seq.load(std::memory_order_acquire) - pos);
+            if (diff == 0) {
+                if (enqueue.pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    c.value = std::move(value);
+                    c.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0) return false;   // the slot still holds last round's item: full
+            else pos = enqueue.pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Claims up to want positions in one step, starting at *first. 0 if there are none.
+    // next is the counter being claimed from, limit how far it may get ahead of the other one.
+    static std::size_t claim(std::atomic<std::uint64_t>& next, const std::atomic<std::uint64_t>& other,
+                             std::size_t want, std::uint64_t ahead, std::uint64_t& first) {
+        std::uint64_t pos = next.load(std::memory_order_relaxed);
+        while (true) {
+            std::int64_t room = static_cast<std::int64_t>(other.load(std::memory_order_acquire) + ahead - pos);
+            if (room <= 0) return 0;
+            std::size_t n = std::min<std::size_t>(want, static_cast<std::size_t>(room));
+            if (next.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed)) {
+                first = pos;
+                return n;
+            }
+        }
+    }
+
+    // The slot was claimed but its last user may still be finishing with it
+    static void waitFor(const Cell& c, std::uint64_t seq) {
+        for (int spins = 0; c.seq.load(std::memory_order_acquire) != seq; ++spins)
+            if (spins > 64) std::this_thread::yield();
+    }
+
+public:
+    explicit MpmcRing(std::size_t capacity, RingPolicy p = RingPolicy::reject)
+        : cap(std::bit_ceil(capacity < 2 ? std::size_t(2) : capacity)), mask(cap - 1), policy(p) {
+        cells = std::make_unique<Cell[]>(cap);
+        for (std::size_t i = 0; i < cap; ++i) cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+    MpmcRing(const MpmcRing&) = delete;
+    MpmcRing& operator=(const MpmcRing&) = delete;
+
+    // false if full and the policy is reject. With overwrite the oldest item is popped and dropped.
+    bool push(T value) {
+        while (!tryPush(value)) {
+            if (policy == RingPolicy::reject) return false;
+            T oldest;
+            if (pop(oldest)) dropCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    bool pop(T& out) {
+        std::uint64_t pos = dequeue.pos.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& c = cell(pos);
+            std::int64_t diff = static_cast<std::int64_t>(c.seq.load(std::memory_order_acquire) - (pos + 1));
+            if (diff == 0) {
+                if (dequeue.pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    out = std::move(c.value);
+                    c.seq.store(pos + cap, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0) return false;   // nothing pushed there yet: empty
+            else pos = dequeue.pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Claims a run of slots with one compare-exchange, then fills them. A slot whose previous
+    // pop is still copying the old item out is waited for, so unlike push this can spin
+    // briefly behind a consumer that got preempted mid-pop. Returns how many went in.
+    std::size_t pushBatch(std::span<const T> values) {
+        std::size_t done = 0;
+        while (done < values.size()) {
+            std::uint64_t first = 0;
+            std::size_t n = claim(enqueue.pos, dequeue.pos, values.size() - done, cap, first);
+            if (n == 0) {
+                if (policy == RingPolicy::reject) break;
+                T oldest;
+                if (pop(oldest)) dropCount.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            for (std::size_t i = 0; i < n; ++i) {
+                Cell& c = cell(first + i);
+                waitFor(c, first + i);
+                c.value = values[done + i];
+                c.seq.store(first + i + 1, std::memory_order_release);
+            }
+            done += n;
+        }
+        return done;
+    }
+
+    // Pops up to out.size() items with one compare-exchange. Same brief wait as pushBatch
+    // for a slot whose push is still writing. Returns how many.
+    std::size_t popBatch(std::span<T> out) {
+        std::uint64_t first = 0;
+        std::size_t n = claim(dequeue.pos, enqueue.pos, out.size(), 0, first);
+        for (std::size_t i = 0; i < n; ++i) {
+            Cell& c = cell(first + i);
+            waitFor(c, first + i + 1);
+            out[i] = std::move(c.value);
+            c.seq.store(first + i + cap, std::memory_order_release);
+        }
+        return n;
+    }
+
+    // Approximate while others are running
+    std::size_t size() const {
+        std::uint64_t t = enqueue.pos.load(std::memory_order_acquire), h = dequeue.pos.load(std::memory_order_acquire);
+        return t > h ? static_cast<std::size_t>(t - h) : 0;
+    }
+    std::size_t capacity() const { return cap; }
+    bool empty() const { return size() == 0; }
+    std::uint64_t dropped() const { return dropCount.load(std::memory_order_relaxed); }
+};
@@ -0,0 +1,505 @@
+#pragma once
+#include <iostream>
+#include <string>
+#include <span>
+#include <functional>   // std::less, std::equal_to
+#include <cstddef>      // std::size_t
+#include <string_view>
+#include <vector>
+#include <bit>          // std::countr_one
+#include <cstdint>      // std::uintptr_t
+#include <utility>      // std::pair, std::declval
+#include <iterator>     // std::begin
+#include <type_traits>
+#include "caseFold.h"
+#include "simdScan.h"
+#include "profilerLite.h"   // probes, compiled in with PROFILER_PROBES=1
+// NOT USING NAMESPACE STD FOR MORE ROBUST CODE
+
+/*
+2. Searcher (templated)
+    Use: Linear search (unsorted), binary search (sorted), and “find first matching predicate.”
+    Steps: Accept container + target/predicate → pick search mode → scan or binary search → return index/iterator + “found” flag.
+    Notes:
+        - binarySearch/search print "found"/"not found" like before.
+          find/findIf/binaryFind are the silent versions and hand back a SearchResult.
+        - SearchIndex (below) is the build-once version for read heavy lookup tables.
+        - binaryFindBatch / SearchIndex::lowerBoundBatch look up a whole span of keys in one call,
+          interleaving the searches so the cache misses overlap instead of queueing up.
+        - find/search/count on ints, floats and doubles (default equality), and findIf/countIf with the
+          built-in predicates (EqualTo, Below, Above, Between) run the SimdScan kernels.
+          Any other lambda takes the plain loop, same answers either way.
+        - With PROFILER_PROBES=1 the scans, binary searches and batches show up in
+          ProfilerLite's report, binary searches with their comparison counts.
+*/
+
+// What the silent searches return. index is the match, or the container size if nothing matched.
+struct SearchResult {
+    std::size_t index = 0;
+    bool found = false;
+
+    explicit operator bool() const { return found; }
+};
+
+class Search {
+private:
+    // Queries searched side by side in binaryFindBatch. Enough to keep the
+    // memory system busy, small enough that the bases stay in registers/L1.
+    static constexpr std::size_t batchGroup = 16;
+
+    static void prefetch(const void* p) {
+#if defined(__GNUC__)
+        __builtin_prefetch(p);
+#else
+        (void)p;
+#endif
+    }
+
+    // Sorted queries: walk forward from the previous answer, galloping (1, 2, 4, ...)
+    // and then binary searching the last gap. Close queries cost a couple of compares,
+    // far apart ones cost about log of the distance.
+    template <typename Elem, typename Query, typename Less>
+    static std::size_t sweepBatch(std::span<Elem> s, std::span<Query> queries, std::span<std::size_t> out, Less& less) {
+        std::size_t pos = 0;
+        for (std::size_t q = 0; q < queries.size(); ++q) {
+            const auto& x = queries[q];
+            std::size_t low = pos, step = 1, high = pos;
+            while (high < s.size() && less(s[high], x)) {
+                low = high + 1;
+                high += step;
+                step *= 2;
+            }
+            if (high > s.size()) high = s.size();
+            while (low < high) {
+                std::size_t mid = low + (high - low) / 2;
+                if (less(s[mid], x)) low = mid + 1;
+                else high = mid;
+            }
+            out[q] = pos = low;
+        }
+        return queries.size();
+    }
+
+    // Unsorted queries: groups of batchGroup do a branchless lower bound in lockstep.
+    // Every query in the group halves the same len at the same time, so the group
+    // issues batchGroup independent loads per level instead of one dependent chain.
+    template <typename Elem, typename Query, typename Less>
+    static std::size_t lockstepBatch(std::span<Elem> s, std::span<Query> queries, std::span<std::size_t> out, Less& less) {
+        const std::size_t n = s.size();
+        std::size_t base[batchGroup];
+        for (std::size_t first = 0; first < queries.size(); first += batchGroup) {
+            std::size_t count = queries.size() - first < batchGroup ? queries.size() - first : batchGroup;
+            const Query* q = queries.data() + first;
+
+            for (std::size_t j = 0; j < count; ++j) base[j] = 0;
+            std::size_t len = n;
+            while (len > 1) {
+                std::size_t half = len / 2;
+                for (std::size_t j = 0; j < count; ++j) {
+                    base[j] += less(s[base[j] + half], q[j]) ? half : 0;
+                }
+                len -= half;
+                // next level probes base + len/2, ask for all of them before anyone waits
+                for (std::size_t j = 0; j < count; ++j) prefetch(s.data() + base[j] + len / 2);
+            }
+            for (std::size_t j = 0; j < count; ++j) {
+                out[first + j] = base[j] + static_cast<std::size_t>(less(s[base[j]], q[j]));
+            }
+        }
+        return queries.size();
+    }
+
+    // The SimdScan question for a predicate: first/count of elements in [lo, hi].
+    // false when it has to go through the generic loop (type or value the kernels can't take).
+    template <typename Elem, typename Pred>
+    static bool scanRange(const Pred& pred, Elem& lo, Elem& hi, bool& none);
+
+    // IsA<P, EqualTo>::value : P is some EqualTo<V>
+    template <typename P, template <typename> class Of>
+    struct IsA : std::false_type {};
+    template <typename V, template <typename> class Of>
+    struct IsA<Of<V>, Of> : std::true_type {};
+
+    template <bool Count, typename S, typename Pred>
+    static std::size_t genericScan(S s, Pred& pred) {
+        std::size_t found = 0;
+        for (std::size_t i = 0; i < s.size(); i++) {
+            if (pred(s[i])) {
+                if constexpr (!Count) return i;
+                ++found;
+            }
+        }
+        return Count ? found : s.size();
+    }
+
+    // Kernel when it applies, generic loop otherwise. Count: number of matches, else first match or size.
+    template <bool Count, typename S, typename Pred>
+    static std::size_t scan(S s, Pred& pred) {
+        PROFILE_PROBE_SCOPE("Search::scan");
+        using Elem = std::remove_cv_t<typename S::element_type>;
+        if constexpr (SimdScan::supports<Elem>) {
+            Elem lo{}, hi{};
+            bool none = false;
+            if (scanRange(pred, lo, hi, none)) {
+                if (none) return Count ? 0 : s.size();
+                return Count ? SimdScan::countInRange(s.data(), s.size(), lo, hi)
+                             : SimdScan::findInRange(s.data(), s.size(), lo, hi);
+            }
+        }
+        return genericScan<Count>(s, pred);
+    }
+
+public:
+    Search() = default;
+
+    // Built-in predicates for findIf/countIf. Plain function objects, so they work on
+    // any element type, but on ints/floats/doubles they get the vectorized kernels.
+    template <typename V>
+    struct EqualTo {
+        V value;
+        template <typename E> bool operator()(const E& x) const { return x == value; }
+    };
+    template <typename V>
+    struct Below {
+        V value;
+        template <typename E> bool operator()(const E& x) const { return x < value; }
+    };
+    template <typename V>
+    struct Above {
+        V value;
+        template <typename E> bool operator()(const E& x) const { return x > value; }
+    };
+    template <typename V>
+    struct Between {   // lo <= x <= hi
+        V lo;
+        V hi;
+        template <typename E> bool operator()(const E& x) const { return lo <= x && x <= hi; }
+    };
+
+    // Binary Search. eq decides a match, less walks the (sorted by less) data,
+    // so a custom comparator does not need operator< on the element anymore.
+    template <typename T, typename Value, typename Eq = std::equal_to<>, typename Less = std::less<>>
+    void binarySearch(T& arr, const Value& x, Eq eq = {}, Less less = {}) const {
+        PROFILE_PROBE_SCOPE("Search::binarySearch");
+        auto&& cmp = ProfilerLite::probed(less);
+        auto s = std::span(arr);
+        std::size_t low{};
+        std::size_t high = s.size();   // half open [low, high)
+        while (low < high) {
+            std::size_t mid = low + (high - low) / 2;
+
+            // Check if x is present at mid
+            if (eq(s[mid], x)) {
+                std::cout << "found" << std::endl;
+                return;
+            }
+
+            // If x greater, ignore left half
+            if (cmp(s[mid], x)) {
+                low = mid + 1;
+            }
+
+            // If x is smaller, ignore right half
+            else {
+                high = mid;
+            }
+        }
+
+        // If we reach here, then element was not present
+        std::cout << "nothing found" << std::endl;
+        return;
+    }
+
+    // Linear Search
+    template <typename T, typename Value, typename Eq = std::equal_to<>>
+    void search(T& arr, const Value& x, Eq eq = {}) const {
+        if (find(arr, x, eq)) {
+            std::cout << "found" << std::endl;
+            return;
+        }
+        std::cout << "not found" << std::endl;
+        return;
+    }
+
+    // Silent linear search: first index where eq(elem, x)
+    template <typename T, typename Value, typename Eq = std::equal_to<>>
+    SearchResult find(T& arr, const Value& x, Eq eq = {}) const {
+        auto s = std::span(arr);
+        using Elem = std::remove_cv_t<typename decltype(s)::element_type>;
+
+        std::size_t i;
+        if constexpr (std::is_same_v<Eq, std::equal_to<>> || std::is_same_v<Eq, std::equal_to<Elem>>) {
+            EqualTo<const Value&> pred{ x };
+            i = scan<false>(s, pred);
+        } else {
+            PROFILE_PROBE_SCOPE("Search::scan");
+            auto pred = [&](const auto& elem) { return eq(elem, x); };
+            i = genericScan<false>(s, pred);
+        }
+        return { i, i < s.size() };
+    }
+
+    // Silent "find first matching predicate"
+    template <typename T, typename Pred>
+    SearchResult findIf(T& arr, Pred pred) const {
+        auto s = std::span(arr);
+        std::size_t i = scan<false>(s, pred);
+        return { i, i < s.size() };
+    }
+
+    // Number of elements equal to x / matching pred
+    template <typename T, typename Value, typename Eq = std::equal_to<>>
+    std::size_t count(T& arr, const Value& x, Eq eq = {}) const {
+        auto s = std::span(arr);
+        using Elem = std::remove_cv_t<typename decltype(s)::element_type>;
+
+        if constexpr (std::is_same_v<Eq, std::equal_to<>> || std::is_same_v<Eq, std::equal_to<Elem>>) {
+            EqualTo<const Value&> pred{ x };
+            return scan<true>(s, pred);
+        } else {
+            PROFILE_PROBE_SCOPE("Search::scan");
+            auto pred = [&](const auto& elem) { return eq(elem, x); };
+            return genericScan<true>(s, pred);
+        }
+    }
+
+    template <typename T, typename Pred>
+    std::size_t countIf(T& arr, Pred pred) const {
+        return scan<true>(std::span(arr), pred);
+    }
+
+    // Silent binary search on data sorted by less. On a hit index is the first
+    // equal element, on a miss it is where x would be inserted (lower bound).
+    template <typename T, typename Value, typename Less = std::less<>>
+    SearchResult binaryFind(T& arr, const Value& x, Less less = {}) const {
+        PROFILE_PROBE_SCOPE("Search::binaryFind");
+        auto&& cmp = ProfilerLite::probed(less);
+        auto s = std::span(arr);
+        std::size_t low{};
+        std::size_t high = s.size();
+        while (low < high) {
+            std::size_t mid = low + (high - low) / 2;
+            if (cmp(s[mid], x)) low = mid + 1;
+            else high = mid;
+        }
+        return { low, low < s.size() && !less(x, s[low]) };
+    }
+
+    // binaryFind for many keys at once. out[i] gets binaryFind(arr, queries[i], less).index
+    // (first equal element, or the insert position on a miss). Sorted queries take a
+    // forward sweep through arr, anything else a lockstep descent of 16 queries at a time.
+    // Only min(queries, out) keys are searched; the filled part of out is returned.
+    template <typename T, typename Q, typename Less = std::less<>>
+    std::span<std::size_t> binaryFindBatch(T& arr, const Q& queries, std::span<std::size_t> out, Less less = {}) const {
+        auto s = std::span(arr);
+        auto qs = std::span(queries);
+        if (qs.size() > out.size()) qs = qs.first(out.size());
+        out = out.first(qs.size());
+        if (qs.empty()) return out;
+        if (s.empty()) {
+            for (std::size_t& o : out) o = 0;
+            return out;
+        }
+
+        PROFILE_PROBE_SCOPE("Search::binaryFindBatch");
+        bool sortedQueries = true;
+        for (std::size_t i = 1; i < qs.size() && sortedQueries; ++i) {
+            sortedQueries = !less(qs[i], qs[i - 1]);
+        }
+        if (sortedQueries) sweepBatch(s, qs, out, less);
+        else lockstepBatch(s, qs, out, less);
+        return out;
+    }
+
+    // Case insensitive string searches
+    template <typename T>
+    void binarySearch_ci(T& v, std::string_view x) const {
+        this->binarySearch(v, x, CaseFold::Equal{}, CaseFold::Less{});
+    }
+    template <typename T>
+    void search_ci(T& v, std::string_view x) const {
+        this->search(v, x, CaseFold::Equal{});
+    }
+    template <typename T>
+    SearchResult find_ci(T& v, std::string_view x) const {
+        return this->find(v, x, CaseFold::Equal{});
+    }
+};
+
+// Which built-in predicate pred is, as a closed range. none = nothing can match.
+template <typename Elem, typename Pred>
+bool Search::scanRange(const Pred& pred, Elem& lo, Elem& hi, bool& none) {
+    Elem v{};
+    if constexpr (IsA<Pred, Between>::value) {
+        return SimdScan::convert(pred.lo, lo, true) && SimdScan::convert(pred.hi, hi, true);
+    } else if constexpr (IsA<Pred, EqualTo>::value) {
+        if (!SimdScan::convert(pred.value, v, false)) return false;
+        lo = hi = v;
+        return true;
+    } else if constexpr (IsA<Pred, Below>::value) {
+        if (!SimdScan::convert(pred.value, v, true)) return false;
+        none = !SimdScan::below(v, lo, hi);
+        return true;
+    } else if constexpr (IsA<Pred, Above>::value) {
+        if (!SimdScan::convert(pred.value, v, true)) return false;
+        none = !SimdScan::above(v, lo, hi);
+        return true;
+    } else {
+        return false;
+    }
+}
+
+/*
+SearchIndex (templated)
+    Use: Build once, look up many times. For big read mostly tables where a plain
+         binary search misses the cache on almost every level.
+    Steps: Take data sorted by less → copy it into Eytzinger (BFS) order, node k has its
+           children at 2k and 2k+1 → descend without branches → turn the node back into
+           the sorted position.
+    Notes:
+        - The top levels of the tree share a handful of cache lines, so they stay hot.
+        - Every step prefetches the 16 descendants four levels down (16k .. 16k+15),
+          so by the time the descent gets there the cache miss is already on its way.
+        - T has to be default constructible, the index keeps its own copy of the data.
+        - Positions returned are positions in the original sorted data (size() = not there).
+*/
+
+template <typename T, typename Less = std::less<>>
+class SearchIndex {
+private:
+    std::vector<T> tree;                // 1-based, tree[0] unused
+    std::vector<std::size_t> sortedPos; // tree slot -> index in the sorted data
+    std::size_t n = 0;
+    Less less;
+
+    // In-order walk of the implicit tree hands out the sorted elements in order
+    template <typename Elem>
+    void layout(std::span<Elem> sorted, std::size_t& next, std::size_t k) {
+        if (k > n) return;
+        layout(sorted, next, 2 * k);
+        tree[k] = sorted[next];
+        sortedPos[k] = next++;
+        layout(sorted, next, 2 * k + 1);
+    }
+
+    void prefetch(std::size_t k) const {
+#if defined(__GNUC__)
+        // 4 levels down is 16 nodes wide; the address math is done on integers
+        // because it may point past the end, which is fine for a prefetch.
+        constexpr std::size_t levelsAhead = 16;
+        std::uintptr_t addr = reinterpret_cast<std::uintptr_t>(tree.data()) + k * levelsAhead * sizeof(T);
+        __builtin_prefetch(reinterpret_cast<const void*>(addr));
+#else
+        (void)k;
+#endif
+    }
+
+    // Slot after the descent -> sorted position. The answer is the last node where
+    // we went left: drop the trailing 1 bits (right turns) and that one 0 bit.
+    std::size_t toPosition(std::size_t k) const {
+        k >>= std::countr_one(k) + 1;
+        return k == 0 ? n : sortedPos[k];
+    }
+
+public:
+    SearchIndex() = default;
+
+    // data must already be sorted by less
+    template <typename Container>
+    explicit SearchIndex(const Container& data, Less l = {}) : less(l) {
+        auto s = std::span(data);
+        using Elem = typename decltype(s)::element_type;
+
+        PROFILE_PROBE_SCOPE("SearchIndex::build");
+        n = s.size();
+        tree.resize(n + 1);
+        sortedPos.resize(n + 1);
+        PROFILE_PROBE_COUNT(allocations, 2);
+        std::size_t next = 0;
+        layout(std::span<Elem>(s), next, 1);
+    }
+
+    std::size_t size() const { return n; }
+
+    // First position whose element is not less than x
+    template <typename Value>
+    std::size_t lowerBound(const Value& x) const {
+        std::size_t k = 1;
+        while (k <= n) {
+            prefetch(k);
+            k = 2 * k + static_cast<std::size_t>(less(tree[k], x));
+        }
+        return toPosition(k);
+    }
+
+    // First position whose element is greater than x
+    template <typename Value>
+    std::size_t upperBound(const Value& x) const {
+        std::size_t k = 1;
+        while (k <= n) {
+            prefetch(k);
+            k = 2 * k + static_cast<std::size_t>(!less(x, tree[k]));
+        }
+        return toPosition(k);
+    }
+
+    // [first, last) positions equal to x
+    template <typename Value>
+    std::pair<std::size_t, std::size_t> equalRange(const Value& x) const {
+        return { lowerBound(x), upperBound(x) };
+    }
+
+    // Like Search::binaryFind: first equal position, or the insert position on a miss
+    template <typename Value>
+    SearchResult find(const Value& x) const {
+        std::size_t k = 1;
+        while (k <= n) {
+            prefetch(k);
+            k = 2 * k + static_cast<std::size_t>(less(tree[k], x));
+        }
+        k >>= std::countr_one(k) + 1;
+        if (k == 0) return { n, false };
+        return { sortedPos[k], !less(x, tree[k]) };
+    }
+
+    template <typename Value>
+    bool contains(const Value& x) const { return find(x).found; }
+
+    // lowerBound for many keys. Groups of 16 descend level by level together, so the
+    // misses of the whole group overlap. Same min(queries, out) rule as binaryFindBatch.
+    template <typename Q>
+    std::span<std::size_t> lowerBoundBatch(const Q& queries, std::span<std::size_t> out) const {
+        constexpr std::size_t group = 16;
+        auto qs = std::span(queries);
+        if (qs.size() > out.size()) qs = qs.first(out.size());
+        out = out.first(qs.size());
+
+        PROFILE_PROBE_SCOPE("SearchIndex::lowerBoundBatch");
+        // Levels every path has, then at most one more partial level
+        const unsigned fullLevels = static_cast<unsigned>(std::bit_width(n + 1)) - 1;
+        std::size_t k[group];
+        for (std::size_t first = 0; first < qs.size(); first += group) {
+            std::size_t count = qs.size() - first < group ? qs.size() - first : group;
+            auto q = qs.subspan(first, count);
+
+            for (std::size_t j = 0; j < count; ++j) k[j] = 1;
+            for (unsigned level = 0; level < fullLevels; ++level) {
+                for (std::size_t j = 0; j < count; ++j) {
+                    prefetch(k[j]);
+                    k[j] = 2 * k[j] + static_cast<std::size_t>(less(tree[k[j]], q[j]));
+                }
+            }
+            for (std::size_t j = 0; j < count; ++j) {
+                if (k[j] <= n) k[j] = 2 * k[j] + static_cast<std::size_t>(less(tree[k[j]], q[j]));
+                out[first + j] = toPosition(k[j]);
+            }
+        }
+        return out;
+    }
+};
+
+// SearchIndex idx(vec) / SearchIndex idx(arr, CaseFold::Less{}) work without spelling out T
+template <typename Container>
+SearchIndex(const Container&) -> SearchIndex<std::remove_cvref_t<decltype(*std::begin(std::declval<const Container&>()))>>;
+template <typename Container, typename Less>
+SearchIndex(const Container&, Less) -> SearchIndex<std::remove_cvref_t<decltype(*std::begin(std::declval<const Container&>()))>, Less>;
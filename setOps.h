@@ -0,0 +1,388 @@
+#pragma once
+#include <algorithm>    // std::copy
+#include <bit>          // std::countr_zero
+#include <cstddef>      // std::size_t
+#include <cstdint>
+#include <functional>   // std::less, std::hash
+#include <iterator>     // std::size, std::begin
+#include <span>
+#include <type_traits>
+#include <utility>      // std::forward
+#include "flatHashSet.h"
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+// NOT USING NAMESPACE STD FOR MORE ROBUST CODE
+
+/*
+4. SetOps (templated)
+    Use: Union / intersection / difference of two sorted lists (id lists, posting lists),
+         plus intersecting many lists at once and a hash version for unsorted lists.
+    Steps: Compare the sizes → similar sizes: merge both lists in one pass (sparse 32 bit id
+           lists compare 4 against 4 per step with SSE2) → one list much smaller: for each of its values,
+           gallop (1, 2, 4, ...) through the big list from where the last one was found →
+           write into the caller's buffer and hand back the filled part.
+    Notes:
+        - Inputs are sets: sorted by less (the same one they were sorted with) and without
+          repeats. Run Deduper first if they might have repeats.
+        - Nothing is allocated by the sorted ops. out needs room for min(a, b) values for
+          intersect, a + b for unite, a for difference; a smaller out gets the first
+          out.size() values of the answer. intersect and difference may write into a itself
+          (results land behind the read position), which is how intersectMany works in place.
+        - Galloping costs about log(big / small) per value of the small list, so a 100 value
+          list against a 10M one takes microseconds, where a merge would walk all 10M.
+        - The unsorted versions build a FlatHashSet of b. Pass one in to reuse its memory
+          across calls. Output follows a's order.
+*/
+
+class SetOps {
+private:
+    // Past this size ratio galloping beats walking the big list
+    static constexpr std::size_t gallopRatio = 32;
+
+    template <typename Elem, typename Less>
+    static constexpr bool simdFriendly = std::is_integral_v<Elem> && sizeof(Elem) == 4 &&
+        (std::is_same_v<Less, std::less<>> || std::is_same_v<Less, std::less<Elem>>);
+
+    template <typename R>
+    using ElemOf = std::remove_cv_t<typename decltype(std::span(std::declval<R&>()))::element_type>;
+
+    // std::copy, except that out may be first itself (in place intersect/difference)
+    template <typename Elem>
+    static Elem* copyDown(const Elem* first, const Elem* last, Elem* out) {
+        if (out == first) return out + (last - first);
+        return std::copy(first, last, out);
+    }
+
+    template <typename Set, typename Elem>
+    static void fill(Set& seen, std::span<const Elem> values) {
+        seen.clear();
+        seen.reserve(values.size());
+        for (const Elem& v : values) seen.insert(v);
+    }
+
+    // First position >= from with !(s[pos] < x): steps 1, 2, 4, ... then binary search the last gap
+    template <typename Elem, typename Less>
+    static std::size_t gallop(std::span<const Elem> s, std::size_t from, const Elem& x, Less& less) {
+        std::size_t n = s.size();
+        if (from >= n || !less(s[from], x)) return from;
+        std::size_t low = from, step = 1;   // s[low] < x
+        while (low + step < n && less(s[low + step], x)) {
+            low += step;
+            step *= 2;
+        }
+        std::size_t high = low + step < n ? low + step : n;   // s[high] >= x or high == n
+        ++low;
+        while (low < high) {
+            std::size_t mid = low + (high - low) / 2;
+            if (less(s[mid], x)) low = mid + 1;
+            else high = mid;
+        }
+        return low;
+    }
+
+    // ================= Intersection =================
+
+    // Branchless merge: both sides step when equal, the smaller side steps otherwise.
+    // k < min(i, j) + 1 <= out's size, so the unconditional store stays in bounds.
+    template <typename Elem, typename Less>
+    static std::size_t mergeIntersect(std::span<const Elem> a, std::span<const Elem> b, Elem* out,
+                                      std::size_t i, std::size_t j, std::size_t k, Less& less) {
+        while (i < a.size() && j < b.size()) {
+            Elem x = a[i], y = b[j];
+            bool xFirst = less(x, y), yFirst = less(y, x);
+            out[k] = x;
+            k += !xFirst && !yFirst;
+            i += !yFirst;
+            j += !xFirst;
+        }
+        return k;
+    }
+
+    // Every value of small looked up in big, galloping forward from the last hit
+    template <typename Elem, typename Less>
+    static std::size_t gallopIntersect(std::span<const Elem> small, std::span<const Elem> big, Elem* out, Less& less) {
+        std::size_t k = 0, pos = 0;
+        for (const Elem& x : small) {
+            pos = gallop(big, pos, x, less);
+            if (pos == big.size()) break;
+            if (!less(x, big[pos])) out[k++] = x;
+        }
+        return k;
+    }
+
+#if defined(__SSE2__) || defined(_M_X64)
+    // 4 x 4 block compare: va against vb and its three rotations says which of a's four
+    // values are in b's block. Then whichever block ends lower moves on (both on a tie).
+    // An a block can meet several b blocks, so its hits are collected and written when it
+    // moves on; writing earlier could overwrite its own lanes when out is a.
+    template <typename Elem>
+    static std::size_t simdIntersect(std::span<const Elem> a, std::span<const Elem> b, Elem* out) {
+        std::size_t i = 0, j = 0, k = 0;
+        std::size_t aEnd = a.size() & ~std::size_t(3), bEnd = b.size() & ~std::size_t(3);
+        unsigned hits = 0;
+        alignas(16) Elem lanes[4];
+        auto flush = [&] {
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes), _mm_loadu_si128(reinterpret_cast<const __m128i*>(a.data() + i)));
+            for (; hits; hits &= hits - 1) out[k++] = lanes[std::countr_zero(hits)];
+        };
+        while (i < aEnd && j < bEnd) {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a.data() + i));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b.data() + j));
+            __m128i hit = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi32(va, vb), _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)))),
+                _mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))),
+                             _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3)))));
+            hits |= static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(hit)));
+            Elem aMax = a[i + 3], bMax = b[j + 3];
+            if (aMax <= bMax) {
+                if (hits) flush();
+                i += 4;
+            }
+            j += bMax <= aMax ? 4 : 0;
+        }
+        if (hits) {
+            // b ran out of blocks: write what the current a block matched and
+            // let the plain merge carry on after its last hit
+            std::size_t last = static_cast<std::size_t>(std::bit_width(hits));
+            flush();
+            i += last;
+        }
+        std::less<> less;
+        return mergeIntersect(a, b, out, i, j, k, less);
+    }
+#endif
+
+    template <typename Elem, typename Less>
+    static std::size_t intersectInto(std::span<const Elem> a, std::span<const Elem> b, Elem* out, Less& less) {
+        if (a.empty() || b.empty()) return 0;
+        if (a.size() * gallopRatio < b.size()) return gallopIntersect(a, b, out, less);
+        if (b.size() * gallopRatio < a.size()) return gallopIntersect(b, a, out, less);
+#if defined(__SSE2__) || defined(_M_X64)
+        if constexpr (simdFriendly<Elem, Less>) {
+            // Blocks win when matches are rare (posting lists, sparse ids). When the lists
+            // fill more than a third of the values they span, most blocks hit and the
+            // branchless merge is faster.
+            std::int64_t lo = a[0] < b[0] ? a[0] : b[0];
+            std::int64_t hi = a.back() > b.back() ? a.back() : b.back();
+            std::size_t shorter = a.size() < b.size() ? a.size() : b.size();
+            if (3 * static_cast<std::uint64_t>(shorter) < static_cast<std::uint64_t>(hi - lo + 1)) return simdIntersect(a, b, out);
+        }
+#endif
+        return mergeIntersect(a, b, out, 0, 0, 0, less);
+    }
+
+    // ================= Union / difference =================
+
+    template <typename Elem, typename Less>
+    static std::size_t uniteInto(std::span<const Elem> a, std::span<const Elem> b, Elem* out, Less& less) {
+        std::size_t i = 0, j = 0, k = 0;
+        // A short list goes in by copying whole stretches of the long one between its values
+        if (a.size() * gallopRatio < b.size() || b.size() * gallopRatio < a.size()) {
+            std::span<const Elem> small = a.size() < b.size() ? a : b, big = a.size() < b.size() ? b : a;
+            for (const Elem& x : small) {
+                std::size_t pos = gallop(big, j, x, less);
+                out = std::copy(big.begin() + static_cast<std::ptrdiff_t>(j), big.begin() + static_cast<std::ptrdiff_t>(pos), out);
+                k += pos - j;
+                j = pos;
+                if (j < big.size() && !less(x, big[j])) ++j;   // equal: write it once
+                *out++ = x;
+                ++k;
+            }
+            std::copy(big.begin() + static_cast<std::ptrdiff_t>(j), big.end(), out);
+            return k + big.size() - j;
+        }
+        while (i < a.size() && j < b.size()) {
+            Elem x = a[i], y = b[j];
+            bool yFirst = less(y, x), xFirst = less(x, y);
+            out[k++] = yFirst ? y : x;
+            i += !yFirst;
+            j += !xFirst;
+        }
+        std::copy(a.begin() + static_cast<std::ptrdiff_t>(i), a.end(), out + k);
+        std::copy(b.begin() + static_cast<std::ptrdiff_t>(j), b.end(), out + k + (a.size() - i));
+        return k + (a.size() - i) + (b.size() - j);
+    }
+
+    template <typename Elem, typename Less>
+    static std::size_t differenceInto(std::span<const Elem> a, std::span<const Elem> b, Elem* out, Less& less) {
+        std::size_t i = 0, j = 0, k = 0;
+        if (b.empty()) {
+            copyDown(a.data(), a.data() + a.size(), out);
+            return a.size();
+        }
+        if (a.size() * gallopRatio < b.size()) {
+            // few values to keep: look each up in b
+            for (const Elem& x : a) {
+                j = gallop(b, j, x, less);
+                if (j == b.size() || less(x, b[j])) out[k++] = x;
+            }
+            return k;
+        }
+        if (b.size() * gallopRatio < a.size()) {
+            // few values to drop: copy the stretches of a between them
+            for (const Elem& y : b) {
+                std::size_t pos = gallop(a, i, y, less);
+                copyDown(a.data() + i, a.data() + pos, out + k);
+                k += pos - i;
+                i = pos;
+                if (i < a.size() && !less(y, a[i])) ++i;
+            }
+            copyDown(a.data() + i, a.data() + a.size(), out + k);
+            return k + a.size() - i;
+        }
+        while (i < a.size() && j < b.size()) {
+            Elem x = a[i], y = b[j];
+            bool xFirst = less(x, y), yFirst = less(y, x);
+            out[k] = x;
+            k += xFirst;
+            i += !yFirst;
+            j += !xFirst;
+        }
+        copyDown(a.data() + i, a.data() + a.size(), out + k);
+        return k + a.size() - i;
+    }
+
+    // out too small for the worst case: compute into a bounded loop instead.
+    // Only taken when the caller gave less room than asked for, so speed doesn't matter.
+    template <typename Elem, typename Less, typename Keep>
+    static std::size_t boundedMerge(std::span<const Elem> a, std::span<const Elem> b, std::span<Elem> out, Less& less, Keep keep) {
+        std::size_t i = 0, j = 0, k = 0;
+        while (k < out.size() && (i < a.size() || j < b.size())) {
+            bool inA = i < a.size(), inB = j < b.size();
+            bool takeA = inA && (!inB || !less(b[j], a[i]));
+            bool takeB = inB && (!inA || !less(a[i], b[j]));
+            const Elem& v = takeA ? a[i] : b[j];
+            if (keep(takeA, takeB)) out[k++] = v;
+            i += takeA;
+            j += takeB;
+        }
+        return k;
+    }
+
+public:
+    // Values in both a and b
+    template <typename A, typename B, typename Out, typename Less = std::less<>>
+    std::span<ElemOf<Out>> intersect(const A& a, const B& b, Out&& out, Less less = {}) const {
+        using Elem = ElemOf<Out>;
+        std::span<const Elem> sa = std::span(a), sb = std::span(b);
+        std::span<Elem> so = std::span(out);
+        if (so.size() >= (sa.size() < sb.size() ? sa.size() : sb.size())) return so.first(intersectInto(sa, sb, so.data(), less));
+        return so.first(boundedMerge(sa, sb, so, less, [](bool inA, bool inB) { return inA && inB; }));
+    }
+
+    // Values in a or b (each once)
+    template <typename A, typename B, typename Out, typename Less = std::less<>>
+    std::span<ElemOf<Out>> unite(const A& a, const B& b, Out&& out, Less less = {}) const {
+        using Elem = ElemOf<Out>;
+        std::span<const Elem> sa = std::span(a), sb = std::span(b);
+        std::span<Elem> so = std::span(out);
+        if (so.size() >= sa.size() + sb.size()) return so.first(uniteInto(sa, sb, so.data(), less));
+        return so.first(boundedMerge(sa, sb, so, less, [](bool, bool) { return true; }));
+    }
+
+    // Values in a but not in b
+    template <typename A, typename B, typename Out, typename Less = std::less<>>
+    std::span<ElemOf<Out>> difference(const A& a, const B& b, Out&& out, Less less = {}) const {
+        using Elem = ElemOf<Out>;
+        std::span<const Elem> sa = std::span(a), sb = std::span(b);
+        std::span<Elem> so = std::span(out);
+        if (so.size() >= sa.size()) return so.first(differenceInto(sa, sb, so.data(), less));
+        return so.first(boundedMerge(sa, sb, so, less, [](bool inA, bool inB) { return inA && !inB; }));
+    }
+
+    // Values in every list. Starts from the smallest list and intersects the running result
+    // with the others in place inside out, so it shrinks fast and soon gallops.
+    // out needs room for the smallest list (a smaller out works through it a piece at a time);
+    // lists is anything spans can be made from, e.g. std::vector<std::span<const int>>.
+    template <typename Lists, typename Out, typename Less = std::less<>>
+    std::span<ElemOf<Out>> intersectMany(const Lists& lists, Out&& out, Less less = {}) const {
+        using Elem = ElemOf<Out>;
+        std::span<Elem> so = std::span(out);
+        std::size_t count = std::size(lists);
+        if (count == 0) return so.first(0);
+
+        auto listAt = [&](std::size_t i) { return std::span<const Elem>(std::span(*(std::begin(lists) + static_cast<std::ptrdiff_t>(i)))); };
+        std::size_t smallest = 0;
+        for (std::size_t i = 1; i < count; ++i) {
+            if (listAt(i).size() < listAt(smallest).size()) smallest = i;
+        }
+        std::span<const Elem> first = listAt(smallest);
+
+        std::size_t filled = 0;
+        for (std::size_t from = 0; from < first.size() && filled < so.size();) {
+            std::size_t take = first.size() - from < so.size() - filled ? first.size() - from : so.size() - filled;
+            Elem* part = so.data() + filled;
+            std::copy(first.begin() + static_cast<std::ptrdiff_t>(from), first.begin() + static_cast<std::ptrdiff_t>(from + take), part);
+            std::size_t size = take;
+            for (std::size_t i = 0; i < count && size > 0; ++i) {
+                if (i != smallest) size = intersectInto(std::span<const Elem>(part, size), listAt(i), part, less);
+            }
+            filled += size;
+            from += take;
+        }
+        return so.first(filled);
+    }
+
+    // ================= Unsorted (hash) versions =================
+    // Inputs must still be free of repeats. Output keeps a's order. seen is scratch space,
+    // reuse one across calls to skip its allocations.
+
+    template <typename A, typename B, typename Out, typename Hash = std::hash<ElemOf<Out>>>
+    std::span<ElemOf<Out>> intersectUnsorted(const A& a, const B& b, Out&& out, FlatHashSet<ElemOf<Out>, Hash>& seen) const {
+        using Elem = ElemOf<Out>;
+        std::span<const Elem> sa = std::span(a), sb = std::span(b);
+        std::span<Elem> so = std::span(out);
+        fill(seen, sb);
+        std::size_t k = 0;
+        for (std::size_t i = 0; i < sa.size() && k < so.size(); ++i) {
+            if (seen.contains(sa[i])) so[k++] = sa[i];
+        }
+        return so.first(k);
+    }
+
+    template <typename A, typename B, typename Out, typename Hash = std::hash<ElemOf<Out>>>
+    std::span<ElemOf<Out>> differenceUnsorted(const A& a, const B& b, Out&& out, FlatHashSet<ElemOf<Out>, Hash>& seen) const {
+        using Elem = ElemOf<Out>;
+        std::span<const Elem> sa = std::span(a), sb = std::span(b);
+        std::span<Elem> so = std::span(out);
+        fill(seen, sb);
+        std::size_t k = 0;
+        for (std::size_t i = 0; i < sa.size() && k < so.size(); ++i) {
+            if (!seen.contains(sa[i])) so[k++] = sa[i];
+        }
+        return so.first(k);
+    }
+
+    // a, then the values of b that aren't in a
+    template <typename A, typename B, typename Out, typename Hash = std::hash<ElemOf<Out>>>
+    std::span<ElemOf<Out>> uniteUnsorted(const A& a, const B& b, Out&& out, FlatHashSet<ElemOf<Out>, Hash>& seen) const {
+        using Elem = ElemOf<Out>;
+        std::span<const Elem> sa = std::span(a), sb = std::span(b);
+        std::span<Elem> so = std::span(out);
+        fill(seen, sa);
+        std::size_t k = 0;
+        for (std::size_t i = 0; i < sa.size() && k < so.size(); ++i) so[k++] = sa[i];
+        for (std::size_t i = 0; i < sb.size() && k < so.size(); ++i) {
+            if (!seen.contains(sb[i])) so[k++] = sb[i];
+        }
+        return so.first(k);
+    }
+
+    // Same, with a set made for the call
+    template <typename A, typename B, typename Out>
+    std::span<ElemOf<Out>> intersectUnsorted(const A& a, const B& b, Out&& out) const {
+        FlatHashSet<ElemOf<Out>> seen;
+        return intersectUnsorted(a, b, std::forward<Out>(out), seen);
+    }
+    template <typename A, typename B, typename Out>
+    std::span<ElemOf<Out>> differenceUnsorted(const A& a, const B& b, Out&& out) const {
+        FlatHashSet<ElemOf<Out>> seen;
+        return differenceUnsorted(a, b, std::forward<Out>(out), seen);
+    }
+    template <typename A, typename B, typename Out>
+    std::span<ElemOf<Out>> uniteUnsorted(const A& a, const B& b, Out&& out) const {
+        FlatHashSet<ElemOf<Out>> seen;
+        return uniteUnsorted(a, b, std::forward<Out>(out), seen);
+    }
+};
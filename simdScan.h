@@ -0,0 +1,271 @@
+#pragma once
+#include <bit>          // std::popcount, std::countr_zero
+#include <cmath>        // std::nextafter
+#include <cstddef>      // std::size_t
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>      // std::in_range
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define SIMDSCAN_AVX2 1
+#endif
+// NOT USING NAMESPACE STD FOR MORE ROBUST CODE
+
+/*
+SimdScan
+    Use: Vectorized kernels behind Search::find / findIf / count / countIf for plain numbers.
+    Steps: Turn the question into "first/number of elements in [lo, hi]" → pick AVX2 (checked once
+           at runtime), SSE2 or plain C++ → test 4 or 8 elements per compare → scalar loop for the tail.
+    Notes:
+        - Works on 32 and 64 bit integers (signed or unsigned), float and double.
+          Other element types (char, short, structs, ...) keep using the generic loop in Search.
+        - Integers use one unsigned compare per lane: x is in [lo, hi] exactly when x - lo <= hi - lo
+          with wrap around, so signed and unsigned share the kernel.
+        - Floats use ordered compares, NaN is never in a range (same answer == and < give).
+        - 64 bit integers need AVX2 (SSE2 has no 64 bit compare), without it they take the scalar loop.
+*/
+
+class SimdScan {
+private:
+    // Integer range as the kernels see it: x - lo <= span, everything unsigned
+    template <typename U>
+    struct IntRange {
+        U lo;
+        U span;
+        bool in(U x) const { return static_cast<U>(x - lo) <= span; }
+    };
+    template <typename F>
+    struct FloatRange {
+        F lo;
+        F hi;
+        bool in(F x) const { return x >= lo && x <= hi; }
+    };
+
+    // Plain C++ version, also does the tail of the vector loops.
+    // Count: returns how many match. Otherwise the first match, or n.
+    template <bool Count, typename T, typename R>
+    static std::size_t scalar(const T* p, std::size_t i, std::size_t n, std::size_t found, R r) {
+        for (; i < n; ++i) {
+            if (r.in(p[i])) {
+                if constexpr (!Count) return i;
+                ++found;
+            }
+        }
+        return Count ? found : n;
+    }
+
+#if defined(__SSE2__)
+    template <bool Count, typename U> requires (sizeof(U) == 4)
+    static std::size_t sse2(const U* p, std::size_t n, IntRange<U> r) {
+        // unsigned compare = signed compare after flipping the sign bits
+        const __m128i sign = _mm_set1_epi32(static_cast<int>(0x80000000u));
+        const __m128i lo = _mm_set1_epi32(static_cast<int>(r.lo));
+        const __m128i span = _mm_xor_si128(_mm_set1_epi32(static_cast<int>(r.span)), sign);
+        std::size_t i = 0, found = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m128i d = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)), lo);
+            __m128i out = _mm_cmpgt_epi32(_mm_xor_si128(d, sign), span);
+            unsigned bits = ~static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(out))) & 0xFu;
+            if constexpr (Count) found += static_cast<std::size_t>(std::popcount(bits));
+            else if (bits) return i + static_cast<std::size_t>(std::countr_zero(bits));
+        }
+        return scalar<Count>(p, i, n, found, r);
+    }
+
+    template <bool Count>
+    static std::size_t sse2(const float* p, std::size_t n, FloatRange<float> r) {
+        const __m128 lo = _mm_set1_ps(r.lo);
+        const __m128 hi = _mm_set1_ps(r.hi);
+        std::size_t i = 0, found = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m128 x = _mm_loadu_ps(p + i);
+            unsigned bits = static_cast<unsigned>(_mm_movemask_ps(_mm_and_ps(_mm_cmpge_ps(x, lo), _mm_cmple_ps(x, hi))));
+            if constexpr (Count) found += static_cast<std::size_t>(std::popcount(bits));
+            else if (bits) return i + static_cast<std::size_t>(std::countr_zero(bits));
+        }
+        return scalar<Count>(p, i, n, found, r);
+    }
+
+    template <bool Count>
+    static std::size_t sse2(const double* p, std::size_t n, FloatRange<double> r) {
+        const __m128d lo = _mm_set1_pd(r.lo);
+        const __m128d hi = _mm_set1_pd(r.hi);
+        std::size_t i = 0, found = 0;
+        for (; i + 2 <= n; i += 2) {
+            __m128d x = _mm_loadu_pd(p + i);
+            unsigned bits = static_cast<unsigned>(_mm_movemask_pd(_mm_and_pd(_mm_cmpge_pd(x, lo), _mm_cmple_pd(x, hi))));
+            if constexpr (Count) found += static_cast<std::size_t>(std::popcount(bits));
+            else if (bits) return i + static_cast<std::size_t>(std::countr_zero(bits));
+        }
+        return scalar<Count>(p, i, n, found, r);
+    }
+#endif
+
+#if defined(SIMDSCAN_AVX2)
+    template <bool Count, typename U> requires (sizeof(U) == 4)
+    __attribute__((target("avx2")))
+    static std::size_t avx2(const U* p, std::size_t n, IntRange<U> r) {
+        const __m256i sign = _mm256_set1_epi32(static_cast<int>(0x80000000u));
+        const __m256i lo = _mm256_set1_epi32(static_cast<int>(r.lo));
+        const __m256i span = _mm256_xor_si256(_mm256_set1_epi32(static_cast<int>(r.span)), sign);
+        std::size_t i = 0, found = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256i d = _mm256_sub_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)), lo);
+            __m256i out = _mm256_cmpgt_epi32(_mm256_xor_si256(d, sign), span);
+            unsigned bits = ~static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(out))) & 0xFFu;
+            if constexpr (Count) found += static_cast<std::size_t>(std::popcount(bits));
+            else if (bits) return i + static_cast<std::size_t>(std::countr_zero(bits));
+        }
+        return scalar<Count>(p, i, n, found, r);
+    }
+
+    template <bool Count, typename U> requires (sizeof(U) == 8)
+    __attribute__((target("avx2")))
+    static std::size_t avx2(const U* p, std::size_t n, IntRange<U> r) {
+        const __m256i sign = _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000ull));
+        const __m256i lo = _mm256_set1_epi64x(static_cast<long long>(r.lo));
+        const __m256i span = _mm256_xor_si256(_mm256_set1_epi64x(static_cast<long long>(r.span)), sign);
+        std::size_t i = 0, found = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m256i d = _mm256_sub_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)), lo);
+            __m256i out = _mm256_cmpgt_epi64(_mm256_xor_si256(d, sign), span);
+            unsigned bits = ~static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(out))) & 0xFu;
+            if constexpr (Count) found += static_cast<std::size_t>(std::popcount(bits));
+            else if (bits) return i + static_cast<std::size_t>(std::countr_zero(bits));
+        }
+        return scalar<Count>(p, i, n, found, r);
+    }
+
+    template <bool Count>
+    __attribute__((target("avx2")))
+    static std::size_t avx2(const float* p, std::size_t n, FloatRange<float> r) {
+        const __m256 lo = _mm256_set1_ps(r.lo);
+        const __m256 hi = _mm256_set1_ps(r.hi);
+        std::size_t i = 0, found = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256 x = _mm256_loadu_ps(p + i);
+            __m256 in = _mm256_and_ps(_mm256_cmp_ps(x, lo, _CMP_GE_OQ), _mm256_cmp_ps(x, hi, _CMP_LE_OQ));
+            unsigned bits = static_cast<unsigned>(_mm256_movemask_ps(in));
+            if constexpr (Count) found += static_cast<std::size_t>(std::popcount(bits));
+            else if (bits) return i + static_cast<std::size_t>(std::countr_zero(bits));
+        }
+        return scalar<Count>(p, i, n, found, r);
+    }
+
+    template <bool Count>
+    __attribute__((target("avx2")))
+    static std::size_t avx2(const double* p, std::size_t n, FloatRange<double> r) {
+        const __m256d lo = _mm256_set1_pd(r.lo);
+        const __m256d hi = _mm256_set1_pd(r.hi);
+        std::size_t i = 0, found = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m256d x = _mm256_loadu_pd(p + i);
+            __m256d in = _mm256_and_pd(_mm256_cmp_pd(x, lo, _CMP_GE_OQ), _mm256_cmp_pd(x, hi, _CMP_LE_OQ));
+            unsigned bits = static_cast<unsigned>(_mm256_movemask_pd(in));
+            if constexpr (Count) found += static_cast<std::size_t>(std::popcount(bits));
+            else if (bits) return i + static_cast<std::size_t>(std::countr_zero(bits));
+        }
+        return scalar<Count>(p, i, n, found, r);
+    }
+
+    static bool hasAvx2() {
+        static const bool yes = __builtin_cpu_supports("avx2");
+        return yes;
+    }
+#endif
+
+    // Best kernel this machine has for the range
+    template <bool Count, typename T, typename R>
+    static std::size_t run(const T* p, std::size_t n, R r) {
+#if defined(SIMDSCAN_AVX2)
+        if (hasAvx2()) return avx2<Count>(p, n, r);
+#endif
+#if defined(__SSE2__)
+        if constexpr (!std::is_integral_v<T> || sizeof(T) == 4) return sse2<Count>(p, n, r);
+#endif
+        return scalar<Count>(p, 0, n, 0, r);
+    }
+
+    // [lo, hi] over any supported T, mapped onto the four kernel types
+    template <bool Count, typename T>
+    static std::size_t inRange(const T* p, std::size_t n, T lo, T hi) {
+        if (!(lo <= hi)) return Count ? 0 : n;   // empty range (or a NaN bound)
+        if constexpr (std::is_floating_point_v<T>) {
+            return run<Count>(p, n, FloatRange<T>{ lo, hi });
+        } else {
+            // read signed elements through their unsigned twin (allowed aliasing)
+            using U = std::make_unsigned_t<T>;
+            return run<Count>(reinterpret_cast<const U*>(p), n,
+                              IntRange<U>{ static_cast<U>(lo), static_cast<U>(static_cast<U>(hi) - static_cast<U>(lo)) });
+        }
+    }
+
+public:
+    // Element types the kernels handle
+    template <typename T>
+    static constexpr bool supports =
+        (std::is_integral_v<T> && !std::is_same_v<T, bool> && (sizeof(T) == 4 || sizeof(T) == 8)) ||
+        std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+    // Turns a search value of type V into an element value with the same meaning.
+    // ordered = the value is used for < / > too, not just ==.
+    // false means the kernels can't answer it the way the C++ compare would, use the generic loop.
+    template <typename T, typename V>
+    static bool convert(const V& v, T& out, bool ordered) {
+        if constexpr (std::is_same_v<V, T>) {
+            out = v;
+            return true;
+        } else if constexpr (std::is_integral_v<T> && std::is_integral_v<V> && !std::is_same_v<V, bool>) {
+            // mixed signedness changes what < means (-1 < 0u is false), == is still fine
+            if (ordered && std::is_signed_v<T> != std::is_signed_v<V>) return false;
+            if (!std::in_range<T>(v)) return false;
+            out = static_cast<T>(v);
+            return true;
+        } else if constexpr (std::is_floating_point_v<T> && std::is_floating_point_v<V>) {
+            out = static_cast<T>(v);
+            return static_cast<V>(out) == v;   // exactly representable (and not NaN)
+        } else {
+            return false;
+        }
+    }
+
+    // First index with lo <= p[i] <= hi, or n
+    template <typename T>
+    static std::size_t findInRange(const T* p, std::size_t n, T lo, T hi) { return inRange<false>(p, n, lo, hi); }
+
+    // Number of elements with lo <= p[i] <= hi
+    template <typename T>
+    static std::size_t countInRange(const T* p, std::size_t n, T lo, T hi) { return inRange<true>(p, n, lo, hi); }
+
+    // x < v and x > v as closed ranges. false = nothing can match.
+    template <typename T>
+    static bool below(T v, T& lo, T& hi) {
+        lo = std::numeric_limits<T>::lowest();
+        if constexpr (std::is_floating_point_v<T>) {
+            lo = -std::numeric_limits<T>::infinity();
+            if (!(v > lo)) return false;
+            hi = std::nextafter(v, lo);
+        } else {
+            if (v == lo) return false;
+            hi = static_cast<T>(v - 1);
+        }
+        return true;
+    }
+    template <typename T>
+    static bool above(T v, T& lo, T& hi) {
+        hi = std::numeric_limits<T>::max();
+        if constexpr (std::is_floating_point_v<T>) {
+            hi = std::numeric_limits<T>::infinity();
+            if (!(v < hi)) return false;
+            lo = std::nextafter(v, hi);
+        } else {
+            if (v == hi) return false;
+            lo = static_cast<T>(v + 1);
+        }
+        return true;
+    }
+};
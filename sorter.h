@@ -1,3 +1,4 @@
+#pragma once
 #include <iostream>
 #include <string>
 #include <vector>
@@ -11,6 +12,12 @@
 #include <utility>      // std::swap
 #include <cstddef>      // std::size_t
 #include <string_view>
+#include <type_traits>  // radix dispatch
+#include <bit>          // std::bit_cast
+#include <cstdint>
+#include "threadPool.h"   // parallel modes
+#include "caseFold.h"     // case insensitive keys/compares
+#include "profilerLite.h" // probes, compiled in with PROFILER_PROBES=1
 // NOT USING NAMESPACE STD FOR MORE ROBUST CODE
 
 /*
@@ -29,95 +36,673 @@
         
 */
 
+// What the silent sorts (introsort, stablesort, ...) hand back instead of printing
+struct SortResult {
+    std::size_t size = 0;       // number of elements
+    bool stable = false;        // equal elements kept their input order
+    const char* engine = "";    // "introsort", "merge", "lsd-radix", "multikey", "presorted", ...
+};
+
 class Sorter {
 private:
     // will contain private functions 
-    template <typename T, typename Less>
-    void mergeSort(T& arr, int left, int right, Less less) {
-        if (left >= right) return;
-
-        int mid = left + (right - left) / 2;
-        mergeSort(arr, left, mid, less);
-        mergeSort(arr, mid + 1, right, less);
-        merge    (arr, left, mid, right, less);
-    }
-
-    template <typename T, typename Less >
-    void merge(T& arr, int left, int mid, int right, Less less) {
-        // Takes span separately of computing the type of the input variable const T& arr
-        // This is because the compilar can't do both at the same type
-        // Ex: std::span<T> arr can't be a function parameter. Compiler can't compute span and T
-        // So it asks you to pass in a variable of type T, w/ computing T
-        auto s = std::span(arr);
+    // ================= Adaptive merge sort engine =================
+    // Bottom up, Timsort style: find the runs that are already in the data
+    // (descending ones get reversed), pad short runs to minRun with binary
+    // insertion sort and merge them off a small run stack. Every merge uses the
+    // same scratch buffer, allocated once per sort, and elements are moved, never copied.
+    // Equal elements always come out of the left run first, so the sort is stable.
+    static constexpr std::size_t maxRunStack = 96;   // run lengths grow like Fibonacci, 96 covers any size_t
 
-        int n1 = mid - left + 1;
-        int n2 = right - mid;
+    // Timsort's minrun: n itself below 64, otherwise a value in [32, 64]
+    // that makes n / minRun a power of two or just under one.
+    static std::size_t minRunLength(std::size_t n) {
+        std::size_t r = 0;
+        while (n >= 64) {
+            r |= n & 1;
+            n >>= 1;
+        }
+        return n + r;
+    }
 
-        using Elem = typename decltype(s)::element_type;
+    // Sorts [low, high) knowing that [low, start) is already sorted
+    template <typename Elem, typename Less>
+    void binaryInsertionSort(std::span<Elem> s, std::size_t low, std::size_t start, std::size_t high, Less& less) {
+        for (std::size_t i = start; i < high; ++i) {
+            // upper bound, so equal elements stay in input order
+            std::size_t l = low, r = i;
+            while (l < r) {
+                std::size_t m = l + (r - l) / 2;
+                if (less(s[i], s[m])) r = m;
+                else l = m + 1;
+            }
+            if (l == i) continue;
+            Elem tmp = std::move(s[i]);
+            std::move_backward(s.begin() + l, s.begin() + i, s.begin() + i + 1);
+            s[l] = std::move(tmp);
+        }
+    }
+
+    // Returns the end of the run starting at low. A strictly descending run is
+    // reversed in place (strictly, so no equal elements swap places).
+    template <typename Elem, typename Less>
+    std::size_t countRun(std::span<Elem> s, std::size_t low, std::size_t high, Less& less) {
+        std::size_t i = low + 1;
+        if (i == high) return high;
+
+        if (less(s[i], s[low])) {
+            while (++i < high && less(s[i], s[i - 1])) {}
+            std::reverse(s.begin() + low, s.begin() + i);
+        }
+        else {
+            while (++i < high && !less(s[i], s[i - 1])) {}
+        }
+        return i;
+    }
 
-        // REAL temp buffers (do not alias s)
-        std::vector<Elem> L;
-        std::vector<Elem> R;
-        L.reserve(n1);
-        R.reserve(n2);
+    // Merges the sorted runs [low, mid) and [mid, high). Only the smaller run
+    // is moved out to buf, so buf never needs more than n / 2 slots.
+    template <typename Elem, typename Less>
+    void mergeRuns(std::span<Elem> s, std::size_t low, std::size_t mid, std::size_t high,
+                   std::vector<Elem>& buf, Less& less) {
+        // Runs already in order (nearly sorted input): nothing to do
+        if (!less(s[mid], s[mid - 1])) return;
 
-        for (int i = 0; i < n1; ++i) L.push_back(s[left + i]);
-        for (int j = 0; j < n2; ++j) R.push_back(s[mid + 1 + j]);
+        PROFILE_PROBE_SCOPE("Sorter::merge runs");
+        buf.clear();
+        if (mid - low <= high - mid) {
+            // Left run into buf, merge front to back
+            buf.insert(buf.end(), std::make_move_iterator(s.begin() + low), std::make_move_iterator(s.begin() + mid));
+            std::size_t i = 0, n1 = buf.size(), j = mid, k = low;
+            while (i < n1 && j < high) {
+                if (!less(s[j], buf[i])) s[k++] = std::move(buf[i++]);   // take from left when equal
+                else                     s[k++] = std::move(s[j++]);
+            }
+            while (i < n1) s[k++] = std::move(buf[i++]);
+            // whatever is left of the right run is already in place
+        }
+        else {
+            // Right run into buf, merge back to front
+            buf.insert(buf.end(), std::make_move_iterator(s.begin() + mid), std::make_move_iterator(s.begin() + high));
+            std::size_t i = mid, j = buf.size(), k = high;
+            while (i > low && j > 0) {
+                if (less(buf[j - 1], s[i - 1])) s[--k] = std::move(s[--i]);
+                else                            s[--k] = std::move(buf[--j]);   // right goes last when equal
+            }
+            while (j > 0) s[--k] = std::move(buf[--j]);
+        }
+    }
+
+    template <typename Elem, typename Less>
+    void adaptiveMergeSort(std::span<Elem> s, Less& less) {
+        std::size_t n = s.size();
+        if (n < 2) return;
 
-        int i = 0, j = 0, k = left;
+        std::size_t minRun = minRunLength(n);
+        std::vector<Elem> buf;
+        if (n > minRun) {
+            buf.reserve(n / 2);
+            PROFILE_PROBE_COUNT(allocations, 1);
+        }
 
-        // Stable merge using comparator:
-        // take from left when equal
-        while (i < n1 && j < n2) {
-            if (!less(R[j], L[i])) {     // i.e., L[i] <= R[j]
-                s[k++] = L[i++];
-            } else {
-                s[k++] = R[j++];
+        std::array<std::size_t, maxRunStack> runBase;
+        std::array<std::size_t, maxRunStack> runLen;
+        std::size_t runs = 0;
+
+        // Merges run i with run i + 1 on the stack
+        auto mergeAt = [&](std::size_t i) {
+            mergeRuns(s, runBase[i], runBase[i + 1], runBase[i + 1] + runLen[i + 1], buf, less);
+            runLen[i] += runLen[i + 1];
+            if (i + 2 < runs) {
+                runBase[i + 1] = runBase[i + 2];
+                runLen[i + 1]  = runLen[i + 2];
+            }
+            --runs;
+        };
+
+        std::size_t low = 0;
+        while (low < n) {
+            std::size_t high;
+            {
+                PROFILE_PROBE_SCOPE("Sorter::find runs");
+                high = countRun(s, low, n, less);
+                if (high - low < minRun) {
+                    std::size_t forced = std::min(n, low + minRun);
+                    binaryInsertionSort(s, low, high, forced, less);
+                    high = forced;
+                }
             }
+            runBase[runs] = low;
+            runLen[runs]  = high - low;
+            ++runs;
+
+            // Keep the Timsort invariants on the top of the stack:
+            // len[i-2] > len[i-1] + len[i] and len[i-1] > len[i]
+            while (runs > 1) {
+                std::size_t i = runs - 2;
+                if ((i > 0 && runLen[i - 1] <= runLen[i] + runLen[i + 1]) ||
+                    (i > 1 && runLen[i - 2] <= runLen[i - 1] + runLen[i])) {
+                    if (runLen[i - 1] < runLen[i + 1]) --i;
+                }
+                else if (runLen[i] > runLen[i + 1]) {
+                    break;
+                }
+                mergeAt(i);
+            }
+            low = high;
         }
 
-        while (i < n1) s[k++] = L[i++];
-        while (j < n2) s[k++] = R[j++];
+        // Merge whatever is left, smallest neighbours first
+        while (runs > 1) {
+            std::size_t i = runs - 2;
+            if (i > 0 && runLen[i - 1] < runLen[i + 1]) --i;
+            mergeAt(i);
+        }
     }
 
-    // Compares both individual strings and is case insensitive by comparing the lowercase version of both string inputs.
-    bool compareStrings(const std::string &a, const std::string &b) {
-        std::string A = a, B = b;
-        transform(A.begin(), A.end(), A.begin(), ::tolower);
-        transform(B.begin(), B.end(), B.begin(), ::tolower);
-        return A < B;
+    // ================= Introsort engine =================
+    // All indices are size_t and ranges are half open [low, high) so spans
+    // bigger than INT_MAX work. Small ranges go to insertion sort, the pivot is a
+    // median of three (ninther for big ranges) and once the recursion gets too deep
+    // the range is finished with heapsort, so the worst case stays O(n log n).
+    static constexpr std::size_t insertionCutoff = 24;
+    static constexpr std::size_t nintherCutoff   = 128;
+
+    template <typename Elem, typename Less>
+    void insertionSort(std::span<Elem> s, std::size_t low, std::size_t high, Less& less) {
+        for (std::size_t i = low + 1; i < high; ++i) {
+            if (!less(s[i], s[i - 1])) continue;
+            // shift the bigger elements right and drop s[i] into the hole
+            Elem tmp = std::move(s[i]);
+            std::size_t j = i;
+            do {
+                s[j] = std::move(s[j - 1]);
+                --j;
+            } while (j > low && less(tmp, s[j - 1]));
+            s[j] = std::move(tmp);
+        }
     }
 
-    // Used for mergesort and deals with upper and lower case characters/strings
-    bool compareStringsMerge(const std::string &a, const std::string &b) {
-        std::string A = a, B = b;
-        transform(A.begin(), A.end(), A.begin(), ::tolower);
-        transform(B.begin(), B.end(), B.begin(), ::tolower);
-        return A <= B;
+    // Returns the index holding the median of s[a], s[b], s[c]
+    template <typename Elem, typename Less>
+    std::size_t medianOfThree(std::span<Elem> s, std::size_t a, std::size_t b, std::size_t c, Less& less) {
+        if (less(s[a], s[b])) {
+            if (less(s[b], s[c])) return b;       // a < b < c
+            return less(s[a], s[c]) ? c : a;      // a < b, c <= b
+        }
+        if (less(s[a], s[c])) return a;           // b <= a < c
+        return less(s[b], s[c]) ? c : b;          // b <= a, c <= a
     }
 
-    template <typename T, std::size_t Extent, typename Less>
-    int partition(std::span<T, Extent> s, int low, int high, Less less) {
-        auto pivot = s[low];      // pivot value (copy)
-        int i = low - 1;
-        int j = high + 1;
+    // Moves the pivot to s[low]. The other sampled elements stay inside
+    // [low + 1, high), so there is always one element <= pivot and one >= pivot
+    // in the range and the partition loops below do not need bounds checks.
+    template <typename Elem, typename Less>
+    void choosePivot(std::span<Elem> s, std::size_t low, std::size_t high, Less& less) {
+        std::size_t n   = high - low;
+        std::size_t mid = low + n / 2;
+        std::size_t m;
+        if (n > nintherCutoff) {
+            // Tukey's ninther: median of the medians of three spread out triples
+            std::size_t step = n / 8;
+            std::size_t m1 = medianOfThree(s, low + 1, low + 1 + step, low + 1 + 2 * step, less);
+            std::size_t m2 = medianOfThree(s, mid - step, mid, mid + step, less);
+            std::size_t m3 = medianOfThree(s, high - 1 - 2 * step, high - 1 - step, high - 1, less);
+            m = medianOfThree(s, m1, m2, m3, less);
+        }
+        else {
+            m = medianOfThree(s, low + 1, mid, high - 1, less);
+        }
+        std::swap(s[low], s[m]);
+        PROFILE_PROBE_COUNT(swaps, 1);
+    }
 
+    // Hoare style partition around the pivot in s[low]. Stops on equal keys from
+    // both sides, so runs of duplicates split evenly instead of going quadratic.
+    // Returns cut such that [low, cut) <= pivot <= [cut, high).
+    template <typename Elem, typename Less>
+    std::size_t partition(std::span<Elem> s, std::size_t low, std::size_t high, Less& less) {
+        std::size_t i = low + 1;
+        std::size_t j = high;
         while (true) {
-            do { ++i; } while (less(s[i], pivot));   // while s[i] < pivot
-            do { --j; } while (less(pivot, s[j]));   // while pivot < s[j]
-
-            if (i >= j) return j;
+            while (less(s[i], s[low])) ++i;
+            --j;
+            while (less(s[low], s[j])) --j;
+            if (!(i < j)) return i;
             std::swap(s[i], s[j]);
+            PROFILE_PROBE_COUNT(swaps, 1);
+            ++i;
+        }
+    }
+
+    template <typename Elem, typename Less>
+    void siftDown(std::span<Elem> s, std::size_t base, std::size_t root, std::size_t n, Less& less) {
+        Elem tmp = std::move(s[base + root]);
+        std::size_t child;
+        while ((child = 2 * root + 1) < n) {
+            if (child + 1 < n && less(s[base + child], s[base + child + 1])) ++child;
+            if (!less(tmp, s[base + child])) break;
+            s[base + root] = std::move(s[base + child]);
+            root = child;
+        }
+        s[base + root] = std::move(tmp);
+    }
+
+    // Fallback used once introSort runs out of depth budget
+    template <typename Elem, typename Less>
+    void heapSort(std::span<Elem> s, std::size_t low, std::size_t high, Less& less) {
+        PROFILE_PROBE_SCOPE("Sorter::heapsort fallback");
+        PROFILE_PROBE_COUNT(swaps, high - low - 1);
+        std::size_t n = high - low;
+        for (std::size_t i = n / 2; i-- > 0; ) siftDown(s, low, i, n, less);
+        for (std::size_t end = n - 1; end > 0; --end) {
+            std::swap(s[low], s[low + end]);
+            siftDown(s, low, 0, end, less);
+        }
+    }
+
+    template <typename Elem, typename Less>
+    void introSort(std::span<Elem> s, std::size_t low, std::size_t high, std::size_t depth, Less& less) {
+        while (high - low > insertionCutoff) {
+            if (depth == 0) {
+                heapSort(s, low, high, less);
+                return;
+            }
+            --depth;
+
+            choosePivot(s, low, high, less);
+            std::size_t cut = partition(s, low, high, less);
+
+            // Recurse into the smaller side and loop on the bigger one,
+            // this keeps the stack at O(log n) frames.
+            if (cut - low < high - cut) {
+                introSort(s, low, cut, depth, less);
+                low = cut;
+            }
+            else {
+                introSort(s, cut, high, depth, less);
+                high = cut;
+            }
+        }
+        insertionSort(s, low, high, less);
+    }
+
+    // 2 * floor(log2(n)), the usual introsort depth budget
+    static std::size_t depthLimit(std::size_t n) {
+        std::size_t depth = 0;
+        while (n > 1) { n >>= 1; ++depth; }
+        return 2 * depth;
+    }
+
+    // ================= Radix engines =================
+    // Picked at compile time by introsort/stablesort when the comparator is a
+    // plain std::less/std::greater and the element type has a natural key:
+    //   - integers and floats: LSD radix sort, one byte per pass
+    //   - std::string (ascending only): multikey quicksort
+    // Any other comparator (lambdas, the _ci wrappers, ...) keeps the comparison sorts.
+    static constexpr std::size_t radixCutoff = 512;   // below this the comparison sorts win
+
+    // 1 = ascending, -1 = descending, 0 = some other comparator
+    template <typename Elem, typename Less>
+    static constexpr int knownOrder() {
+        if constexpr (std::is_same_v<Less, std::less<>> || std::is_same_v<Less, std::less<Elem>>) return 1;
+        else if constexpr (std::is_same_v<Less, std::greater<>> || std::is_same_v<Less, std::greater<Elem>>) return -1;
+        else return 0;
+    }
+
+    template <typename Elem>
+    static constexpr bool radixNumber = (std::is_integral_v<Elem> && !std::is_same_v<Elem, bool>) ||
+                                        std::is_same_v<Elem, float> || std::is_same_v<Elem, double>;
+
+    // Maps a number to an unsigned key with the same order: flip the sign bit of
+    // signed ints; for IEEE floats flip all bits of negatives and only the sign
+    // bit of positives (so -0.0 lands just before +0.0).
+    template <typename Elem>
+    static auto radixKey(Elem x) {
+        if constexpr (std::is_floating_point_v<Elem>) {
+            using U = std::conditional_t<sizeof(Elem) == 4, std::uint32_t, std::uint64_t>;
+            constexpr U signBit = U(1) << (sizeof(U) * 8 - 1);
+            U u = std::bit_cast<U>(x);
+            return (u & signBit) ? U(~u) : U(u | signBit);
+        }
+        else {
+            using U = std::make_unsigned_t<Elem>;
+            U u = static_cast<U>(x);
+            if constexpr (std::is_signed_v<Elem>) u ^= U(U(1) << (sizeof(U) * 8 - 1));
+            return u;
+        }
+    }
+
+    // Stable LSD radix sort. All byte histograms are built in one pass and
+    // bytes that are the same for every element are skipped.
+    template <typename Elem, bool Descending>
+    void lsdRadixSort(std::span<Elem> s) {
+        constexpr std::size_t passes = sizeof(Elem);
+        std::size_t n = s.size();
+
+        std::array<std::array<std::size_t, 256>, passes> counts{};
+        for (const Elem& x : s) {
+            auto k = radixKey(x);
+            if constexpr (Descending) k = decltype(k)(~k);
+            for (std::size_t p = 0; p < passes; ++p) ++counts[p][(k >> (8 * p)) & 0xFF];
+        }
+
+        std::vector<Elem> buf(n);
+        PROFILE_PROBE_COUNT(allocations, 1);
+        Elem* src = s.data();
+        Elem* dst = buf.data();
+        for (std::size_t p = 0; p < passes; ++p) {
+            std::array<std::size_t, 256>& c = counts[p];
+            auto first = radixKey(src[0]);
+            if constexpr (Descending) first = decltype(first)(~first);
+            if (c[(first >> (8 * p)) & 0xFF] == n) continue;   // same byte everywhere
+
+            std::size_t sum = 0;
+            for (std::size_t& x : c) {
+                std::size_t tmp = x;
+                x = sum;
+                sum += tmp;
+            }
+            for (std::size_t i = 0; i < n; ++i) {
+                auto k = radixKey(src[i]);
+                if constexpr (Descending) k = decltype(k)(~k);
+                dst[c[(k >> (8 * p)) & 0xFF]++] = src[i];
+            }
+            std::swap(src, dst);
         }
+        if (src != s.data()) std::copy(src, src + n, s.data());
+    }
+
+    // Character at depth d, shifted by one so that 0 means "string ended here"
+    static int charAt(const std::string& str, std::size_t d) {
+        return d < str.size() ? static_cast<unsigned char>(str[d]) + 1 : 0;
     }
 
-    template <typename T, std::size_t Extent, typename Less>
-    void quickSort(std::span<T, Extent> s, int low, int high, Less less) {
-        if (low >= high) return;
+    // Insertion sort for strings that all share their first d characters
+    void stringInsertionSort(std::span<std::string> s, std::size_t low, std::size_t high, std::size_t d) {
+        for (std::size_t i = low + 1; i < high; ++i) {
+            for (std::size_t j = i; j > low && s[j].compare(d, std::string::npos, s[j - 1], d, std::string::npos) < 0; --j) {
+                std::swap(s[j], s[j - 1]);
+                PROFILE_PROBE_COUNT(swaps, 1);
+            }
+        }
+    }
 
-        int p = partition(s, low, high, less);
-        quickSort(s, low, p, less);        // left:  [low..p]
-        quickSort(s, p + 1, high, less);   // right: [p+1..high]
+    // Bentley/Sedgewick multikey quicksort: three way partition on the character
+    // at depth d, the "equal" part moves on to d + 1. Every character is looked at
+    // about once instead of once per comparison like a string compare does.
+    void multikeyQuickSort(std::span<std::string> s, std::size_t low, std::size_t high, std::size_t d) {
+        while (high - low > insertionCutoff) {
+            std::size_t mid = low + (high - low) / 2;
+            int a = charAt(s[low], d), b = charAt(s[mid], d), c = charAt(s[high - 1], d);
+            int v = std::max(std::min(a, b), std::min(std::max(a, b), c));   // median of three
+
+            // [low, lt) < v, [lt, gt) == v, [gt, high) > v
+            std::size_t lt = low, i = low, gt = high;
+            while (i < gt) {
+                int ch = charAt(s[i], d);
+                if (ch < v) {
+                    std::swap(s[lt++], s[i++]);
+                    PROFILE_PROBE_COUNT(swaps, 1);
+                }
+                else if (ch > v) {
+                    std::swap(s[i], s[--gt]);
+                    PROFILE_PROBE_COUNT(swaps, 1);
+                }
+                else ++i;
+            }
+            // Recurse into the two smaller parts and loop on the biggest one: every call
+            // gets at most half the range, so the stack stays O(log n) deep however long
+            // the strings are. v == 0: the middle strings all ended here, they are equal.
+            std::size_t below = lt - low, same = gt - lt, above = high - gt;
+            if (same >= below && same >= above) {
+                multikeyQuickSort(s, low, lt, d);
+                multikeyQuickSort(s, gt, high, d);
+                if (v == 0) return;
+                low = lt;
+                high = gt;
+                ++d;
+            }
+            else if (below >= above) {
+                if (v != 0) multikeyQuickSort(s, lt, gt, d + 1);
+                multikeyQuickSort(s, gt, high, d);
+                high = lt;
+            }
+            else {
+                multikeyQuickSort(s, low, lt, d);
+                if (v != 0) multikeyQuickSort(s, lt, gt, d + 1);
+                low = gt;
+            }
+        }
+        stringInsertionSort(s, low, high, d);
+    }
+
+    // Runs a radix engine if Elem/Less allow one and returns its name. Returns
+    // nullptr if the caller has to fall back to a comparison sort.
+    template <typename Elem, typename Less>
+    const char* radixSort(std::span<Elem> s, bool stableOnly) {
+        constexpr int order = knownOrder<Elem, Less>();
+        if (s.size() < radixCutoff) return nullptr;
+
+        if constexpr (order != 0 && (radixNumber<Elem> || (order > 0 && std::is_same_v<Elem, std::string>))) {
+            // Radix sort costs the same on presorted data, one cheap pass catches that case
+            Less less{};
+            std::size_t i = 1;
+            while (i < s.size() && !less(s[i], s[i - 1])) ++i;
+            if (i == s.size()) return "presorted";
+        }
+
+        if constexpr (order != 0 && radixNumber<Elem>) {
+            // Floats that compare equal can still differ (-0.0 and +0.0), a stable sort has to keep their order
+            if (stableOnly && std::is_floating_point_v<Elem>) return nullptr;
+            PROFILE_PROBE_SCOPE("Sorter::lsd-radix");
+            lsdRadixSort<Elem, (order < 0)>(s);
+            return "lsd-radix";
+        }
+        else if constexpr (order > 0 && std::is_same_v<Elem, std::string>) {
+            (void)stableOnly;   // equal std::strings are identical, any order is stable
+            PROFILE_PROBE_SCOPE("Sorter::multikey");
+            multikeyQuickSort(s, 0, s.size(), 0);
+            return "multikey";
+        }
+        else {
+            (void)stableOnly;
+            return nullptr;
+        }
+    }
+
+    // ================= Sort by key =================
+    // key(elem) is computed once per element, the (key, index) pairs are sorted
+    // and the elements are moved into place at the end. Worth it whenever the
+    // key is expensive compared to a compare of two keys (like lower casing).
+    template <typename Elem, typename KeyFn, typename Less>
+    void keyedSort(std::span<Elem> s, KeyFn& key, Less& less, bool stable) {
+        using Key = std::decay_t<std::invoke_result_t<KeyFn&, const Elem&>>;
+        struct Keyed {
+            Key key;
+            std::size_t index;
+        };
+
+        std::size_t n = s.size();
+        if (n < 2) return;
+
+        std::vector<Keyed> keyed;
+        {
+            PROFILE_PROBE_SCOPE("Sorter::make keys");
+            keyed.reserve(n);
+            PROFILE_PROBE_COUNT(allocations, 1);
+            for (std::size_t i = 0; i < n; ++i) keyed.push_back({ key(s[i]), i });
+        }
+
+        auto byKey = [&less](const Keyed& a, const Keyed& b) { return less(a.key, b.key); };
+        auto&& cmp = ProfilerLite::probed(byKey);
+        std::span<Keyed> ks(keyed);
+        {
+            PROFILE_PROBE_SCOPE("Sorter::sort keys");
+            if (stable) adaptiveMergeSort(ks, cmp);
+            else        introSort(ks, 0, n, depthLimit(n), cmp);
+        }
+
+        PROFILE_PROBE_SCOPE("Sorter::gather");
+        std::vector<Elem> sorted;
+        sorted.reserve(n);
+        PROFILE_PROBE_COUNT(allocations, 1);
+        for (const Keyed& k : keyed) sorted.push_back(std::move(s[k.index]));
+        std::move(sorted.begin(), sorted.end(), s.begin());
+    }
+
+    // Sort key of the _ci wrappers
+    static std::string foldKey(const std::string& str) { return CaseFold::lower(str); }
+
+    // ================= Parallel engines =================
+    // Ranges below parallelGrain are not worth a task and get sorted on one thread.
+    static constexpr std::size_t parallelGrain = std::size_t(1) << 14;
+
+    // Introsort where the smaller side of every partition becomes a pool task.
+    // Thieves take the oldest task first, which is the biggest one still waiting.
+    template <typename Elem, typename Less>
+    void parallelIntroSort(std::span<Elem> s, std::size_t low, std::size_t high, std::size_t depth,
+                           Less less, ThreadPool::TaskGroup& group) {
+        while (high - low > parallelGrain) {
+            if (depth == 0) {
+                heapSort(s, low, high, less);
+                return;
+            }
+            --depth;
+
+            choosePivot(s, low, high, less);
+            std::size_t cut = partition(s, low, high, less);
+
+            if (cut - low < high - cut) {
+                group.run([this, s, low, cut, depth, less, &group] {
+                    parallelIntroSort(s, low, cut, depth, less, group);
+                });
+                low = cut;
+            }
+            else {
+                group.run([this, s, cut, high, depth, less, &group] {
+                    parallelIntroSort(s, cut, high, depth, less, group);
+                });
+                high = cut;
+            }
+        }
+        introSort(s, low, high, depth, less);
+    }
+
+    // Merge path split: how many of the first d outputs of the stable merge of
+    // a and b come from a (ties go to a).
+    template <typename Elem, typename Less>
+    std::size_t mergePathSplit(std::span<Elem> a, std::span<Elem> b, std::size_t d, Less& less) {
+        std::size_t lo = d > b.size() ? d - b.size() : 0;
+        std::size_t hi = std::min(d, a.size());
+        while (lo < hi) {
+            std::size_t mid = lo + (hi - lo) / 2;
+            // a[mid] <= b[d - mid - 1] means a[mid] is among the first d outputs
+            if (!less(b[d - mid - 1], a[mid])) lo = mid + 1;
+            else hi = mid;
+        }
+        return lo;
+    }
+
+    // Stable merge of a and b, moved into out (out.size() == a.size() + b.size())
+    template <typename Elem, typename Less>
+    void moveMerge(std::span<Elem> a, std::span<Elem> b, std::span<Elem> out, Less& less) {
+        std::size_t i = 0, j = 0, k = 0;
+        while (i < a.size() && j < b.size()) {
+            if (!less(b[j], a[i])) out[k++] = std::move(a[i++]);
+            else                   out[k++] = std::move(b[j++]);
+        }
+        while (i < a.size()) out[k++] = std::move(a[i++]);
+        while (j < b.size()) out[k++] = std::move(b[j++]);
+    }
+
+    // Sorts one chunk per thread with the adaptive merge sort, then merges the
+    // chunks pairwise, level by level, ping-ponging between s and one scratch copy.
+    // Each pair merge is cut into pieces along the merge path so every level
+    // runs on all threads, not just on the number of pairs left.
+    template <typename Elem, typename Less>
+    void parallelMergeSort(std::span<Elem> s, Less less, ThreadPool& pool) {
+        std::size_t n = s.size();
+        std::size_t chunks = std::min(pool.size() + 1, n / parallelGrain);   // + 1: the caller helps too
+        if (chunks < 2) {
+            adaptiveMergeSort(s, less);
+            return;
+        }
+
+        std::vector<std::size_t> bounds(chunks + 1);
+        for (std::size_t i = 0; i <= chunks; ++i) bounds[i] = n / chunks * i + std::min(i, n % chunks);
+
+        {
+            PROFILE_PROBE_SCOPE("Sorter::parallel chunks");
+            ThreadPool::TaskGroup group(pool);
+            for (std::size_t i = 0; i < chunks; ++i) {
+                group.run([this, s, &bounds, i, less]() mutable {
+                    adaptiveMergeSort(s.subspan(bounds[i], bounds[i + 1] - bounds[i]), less);
+                });
+            }
+            group.wait();
+        }
+
+        std::vector<Elem> scratch(std::make_move_iterator(s.begin()), std::make_move_iterator(s.end()));
+        PROFILE_PROBE_COUNT(allocations, 1);
+        std::span<Elem> src(scratch);
+        std::span<Elem> dst(s);
+        std::size_t piece = std::max(parallelGrain, n / (4 * (pool.size() + 1)));
+
+        while (bounds.size() > 2) {
+            PROFILE_PROBE_SCOPE("Sorter::parallel merge level");
+            std::vector<std::size_t> next;
+            ThreadPool::TaskGroup group(pool);
+            for (std::size_t r = 0; r + 1 < bounds.size(); r += 2) {
+                next.push_back(bounds[r]);
+                std::size_t low = bounds[r];
+
+                if (r + 2 >= bounds.size()) {
+                    // odd run out, just move it across
+                    std::size_t high = bounds[r + 1];
+                    group.run([src, dst, low, high] {
+                        std::move(src.begin() + low, src.begin() + high, dst.begin() + low);
+                    });
+                    continue;
+                }
+
+                std::span<Elem> a = src.subspan(low, bounds[r + 1] - low);
+                std::span<Elem> b = src.subspan(bounds[r + 1], bounds[r + 2] - bounds[r + 1]);
+                std::size_t total = a.size() + b.size();
+                // All split points are found before any piece starts: once a piece
+                // runs, the elements it moved out of src can't be compared anymore.
+                std::vector<std::size_t> splits;
+                for (std::size_t d = 0; d < total; d += piece) splits.push_back(mergePathSplit(a, b, d, less));
+                splits.push_back(a.size());
+
+                for (std::size_t k = 0; k + 1 < splits.size(); ++k) {
+                    std::size_t d = k * piece, dEnd = std::min(total, d + piece);
+                    std::size_t i0 = splits[k], i1 = splits[k + 1];
+                    group.run([this, a, b, dst, low, d, dEnd, i0, i1, less]() mutable {
+                        moveMerge(a.subspan(i0, i1 - i0), b.subspan(d - i0, (dEnd - i1) - (d - i0)),
+                                  dst.subspan(low + d, dEnd - d), less);
+                    });
+                }
+            }
+            next.push_back(n);
+            group.wait();
+
+            bounds.swap(next);
+            std::swap(src, dst);
+        }
+
+        // After the last swap src holds the result
+        if (src.data() != s.data()) std::move(src.begin(), src.end(), s.begin());
+    }
+
+    // Prints the sorted data the way quicksort/msort always have
+    template <typename Span>
+    void printSorted(const char* label, Span s) {
+        std::cout << label;
+        for (std::size_t i = 0; i < s.size(); i++) {
+            std::cout << s[i] << ", ";
+        }
+        std::cout << "\n\n";
     }
 
 public:
@@ -137,14 +722,41 @@ public:
             return;
         }
 
-        int high = static_cast<int>(s.size()) - 1;   // safe unless size > INT_MAX
-        quickSort(s, 0, high, less);
+        introsort(arr, less);
 
-        std::cout << "Quick Sort: ";
-        for (int i = 0; i < s.size(); i++) {
-            std::cout << s[i] << ", ";
-        }
-        std::cout << "\n\n";
+        printSorted("Quick Sort: ", s);
+    }
+
+    // Introsort without any printing. Used by quicksort, but can be called
+    // directly when the sorted data is all that is needed.
+    // Numbers and std::strings with std::less/std::greater take a radix sort instead.
+    template <typename T, typename Less = std::less<>>
+    SortResult introsort(T& arr, Less less = {}) {
+        auto s = std::span(arr);
+        using Elem = typename decltype(s)::element_type;
+
+        std::span<Elem> all(s);
+        if (all.size() < 2) return { all.size(), true, "presorted" };
+        PROFILE_PROBE_SCOPE("Sorter::introsort");
+        if (const char* radix = radixSort<Elem, Less>(all, false)) return { all.size(), false, radix };
+        auto&& cmp = ProfilerLite::probed(less);
+        introSort(all, 0, all.size(), depthLimit(all.size()), cmp);
+        return { all.size(), false, "introsort" };
+    }
+
+    // Stable adaptive merge sort without any printing (used by msort).
+    // Close to linear when the data is already made of a few sorted runs.
+    template <typename T, typename Less = std::less<>>
+    SortResult stablesort(T& arr, Less less = {}) {
+        auto s = std::span(arr);
+        using Elem = typename decltype(s)::element_type;
+
+        std::span<Elem> all(s);
+        PROFILE_PROBE_SCOPE("Sorter::stablesort");
+        if (const char* radix = radixSort<Elem, Less>(all, true)) return { all.size(), true, radix };
+        auto&& cmp = ProfilerLite::probed(less);
+        adaptiveMergeSort(all, cmp);
+        return { all.size(), true, "merge" };
     }
 
     template <typename T, typename Less = std::less<>>
@@ -155,28 +767,133 @@ public:
             return;
         }
 
-        int high = static_cast<int>(s.size()) - 1;
-        mergeSort(s, 0, high, less);
+        stablesort(arr, less);
 
-        std::cout << "Merge Sort: ";
-        for (int i = 0; i < s.size(); i++) {
-            std::cout << s[i] << ", ";
-        }
-        std::cout << "\n\n";
+        printSorted("Merge Sort: ", s);
+    }
+    // Sorts by key(elem) with key called once per element instead of twice per compare
+    template <typename T, typename KeyFn, typename Less = std::less<>>
+    SortResult sortByKey(T& arr, KeyFn key, Less less = {}) {
+        auto s = std::span(arr);
+        using Elem = typename decltype(s)::element_type;
+
+        PROFILE_PROBE_SCOPE("Sorter::sortByKey");
+        keyedSort(std::span<Elem>(s), key, less, false);
+        return { s.size(), false, "keyed-introsort" };
     }
-    // Case insensitive lambda for string sorting (quicksort)
+
+    // Stable version of sortByKey
+    template <typename T, typename KeyFn, typename Less = std::less<>>
+    SortResult stableSortByKey(T& arr, KeyFn key, Less less = {}) {
+        auto s = std::span(arr);
+        using Elem = typename decltype(s)::element_type;
+
+        PROFILE_PROBE_SCOPE("Sorter::stableSortByKey");
+        keyedSort(std::span<Elem>(s), key, less, true);
+        return { s.size(), true, "keyed-merge" };
+    }
+
+    // Case insensitive string sorting (quicksort). Each string is lower cased
+    // once up front instead of twice per comparison.
     template <typename T>
     void quicksort_ci(T& v) {
-        // lambda is defined *inside the class*, not in main
-        this->quicksort(v, [this](const std::string& a, const std::string& b) {
-            return compareStrings(std::string_view(a), b);
-        });
+        auto s = std::span(v);
+        if (s.empty()) {
+            std::cout << "data set is empty\n";
+            return;
+        }
+        sortByKey(v, foldKey);
+        printSorted("Quick Sort: ", s);
     }
-    // Case insensitive lambda for string sorting (merge sort)
+    // Case insensitive string sorting (merge sort), stable
     template <typename T>
     void msort_ci(T& v) {
-        this->msort(v, [this](const std::string& a, const std::string& b) {
-            return compareStringsMerge(std::string_view(a), b);
-        });
+        auto s = std::span(v);
+        if (s.empty()) {
+            std::cout << "data set is empty\n";
+            return;
+        }
+        stableSortByKey(v, foldKey);
+        printSorted("Merge Sort: ", s);
+    }
+
+    // ================= Parallel mode =================
+    // Same comparators as the serial sorts. Pass a thread count (0 = one per
+    // hardware thread) or a ThreadPool to reuse across sorts. The comparator is
+    // copied into the tasks and called from several threads at once.
+
+    template <typename T, typename Less = std::less<>>
+    SortResult parallel_introsort(T& arr, ThreadPool& pool, Less less = {}) {
+        auto s = std::span(arr);
+        using Elem = typename decltype(s)::element_type;
+
+        std::span<Elem> all(s);
+        if (all.size() < 2) return { all.size(), true, "presorted" };
+        PROFILE_PROBE_SCOPE("Sorter::parallel_introsort");
+        ThreadPool::TaskGroup group(pool);
+        parallelIntroSort(all, 0, all.size(), depthLimit(all.size()), less, group);
+        group.wait();
+        return { all.size(), false, "parallel-introsort" };
+    }
+
+    template <typename T, typename Less = std::less<>>
+    SortResult parallel_introsort(T& arr, std::size_t threads, Less less = {}) {
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        if (threads == 1) return introsort(arr, less);
+        ThreadPool pool(threads - 1);   // the calling thread is the last one
+        return parallel_introsort(arr, pool, less);
+    }
+
+    // Stable, like stablesort
+    template <typename T, typename Less = std::less<>>
+    SortResult parallel_stablesort(T& arr, ThreadPool& pool, Less less = {}) {
+        auto s = std::span(arr);
+        using Elem = typename decltype(s)::element_type;
+
+        PROFILE_PROBE_SCOPE("Sorter::parallel_stablesort");
+        parallelMergeSort(std::span<Elem>(s), less, pool);
+        return { s.size(), true, "parallel-merge" };
+    }
+
+    template <typename T, typename Less = std::less<>>
+    SortResult parallel_stablesort(T& arr, std::size_t threads, Less less = {}) {
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        if (threads == 1) return stablesort(arr, less);
+        ThreadPool pool(threads - 1);
+        return parallel_stablesort(arr, pool, less);
+    }
+
+    // Printing versions, same output as quicksort/msort.
+    // Exec is either a thread count or a ThreadPool&.
+    template <typename T, typename Exec, typename Less = std::less<>>
+    void parallel_quicksort(T& arr, Exec&& exec, Less less = {}) {
+        auto s = std::span(arr);
+        if (s.empty()) {
+            std::cout << "data set is empty\n";
+            return;
+        }
+        parallel_introsort(arr, std::forward<Exec>(exec), less);
+        printSorted("Quick Sort: ", s);
+    }
+
+    template <typename T, typename Exec, typename Less = std::less<>>
+    void parallel_msort(T& arr, Exec&& exec, Less less = {}) {
+        auto s = std::span(arr);
+        if (s.empty()) {
+            std::cout << "data set is empty\n";
+            return;
+        }
+        parallel_stablesort(arr, std::forward<Exec>(exec), less);
+        printSorted("Merge Sort: ", s);
+    }
+
+    // Case insensitive versions of the above, using the allocation free CaseFold compare
+    template <typename T, typename Exec>
+    void parallel_quicksort_ci(T& v, Exec&& exec) {
+        this->parallel_quicksort(v, std::forward<Exec>(exec), CaseFold::Less{});
+    }
+    template <typename T, typename Exec>
+    void parallel_msort_ci(T& v, Exec&& exec) {
+        this->parallel_msort(v, std::forward<Exec>(exec), CaseFold::Less{});
     }
 };
\ No newline at end of file
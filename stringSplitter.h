@@ -0,0 +1,163 @@
+#pragma once
+#include <bit>          // std::countr_zero, std::popcount
+#include <cstddef>      // std::size_t
+#include <cstdint>
+#include <cstring>      // std::memcpy
+#include <string_view>
+#include <vector>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+// NOT USING NAMESPACE STD FOR MORE ROBUST CODE
+
+/*
+11. StringSplitter
+    Use: Split on a delimiter (fields, paths, key lists), split lines, trim tokens, without
+         copying: every token is a std::string_view into the input.
+    Steps: Compare 16 input bytes against the delimiter at once (SSE2) → a bit mask of the
+           hits → walk the set bits, each one ends a token → the rest of the input is the
+           last token.
+    Notes:
+        - Tokens point into the input, so the input has to outlive them.
+        - forEach(s, delim, f) calls f(token) with no allocation at all; split(s, delim)
+          collects into a vector (pass one in to reuse its memory between calls).
+        - keepEmpty = false drops empty tokens ("a,,b" -> a, b), trimTokens strips spaces and
+          tabs around every token (and drops it if nothing is left and keepEmpty is false).
+        - ByteScan is the SIMD part on its own (find / count / mask any of a few bytes);
+          CSVTableLite runs its quote and newline search on it too. Without SSE2 it does the
+          same 8 bytes at a time in plain 64 bit integers.
+*/
+
+class ByteScan {
+public:
+    static constexpr std::size_t block = 16;
+
+#if defined(__SSE2__) || defined(_M_X64)
+    // Bit i set where p[i] is one of the wanted bytes. Reads exactly 16 bytes.
+    template <typename... C>
+    static std::uint32_t match(const char* p, C... wanted) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i hit = _mm_setzero_si128();
+        ((hit = _mm_or_si128(hit, _mm_cmpeq_epi8(bytes, _mm_set1_epi8(wanted)))), ...);
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(hit));
+    }
+#else
+    // High bit of every byte of x that is zero
+    static std::uint64_t zeroBytes(std::uint64_t x) {
+        constexpr std::uint64_t low7 = 0x7f7f7f7f7f7f7f7full;
+        return ~(((x & low7) + low7) | x | low7);
+    }
+    static std::uint32_t highBits(std::uint64_t x) {
+        std::uint32_t m = 0;
+        for (int b = 0; b < 8; ++b) m |= static_cast<std::uint32_t>((x >> (8 * b + 7)) & 1) << b;
+        return m;
+    }
+    template <typename... C>
+    static std::uint32_t match(const char* p, C... wanted) {
+        std::uint64_t half[2];
+        std::memcpy(half, p, sizeof(half));
+        std::uint32_t m = 0;
+        for (int h = 0; h < 2; ++h) {
+            std::uint64_t hit = 0;
+            ((hit |= zeroBytes(half[h] ^ (0x0101010101010101ull * static_cast<unsigned char>(wanted)))), ...);
+            m |= highBits(hit) << (8 * h);
+        }
+        return m;
+    }
+#endif
+
+    // Same for the last n < 16 bytes, never reads past p + n
+    template <typename... C>
+    static std::uint32_t matchTail(const char* p, std::size_t n, C... wanted) {
+        char buf[block] = {};
+        std::memcpy(buf, p, n);
+        return match(buf, wanted...) & ((std::uint32_t(1) << n) - 1);
+    }
+
+    // Calls f(i) for every i in [0, n) where p[i] is one of the wanted bytes, in order
+    template <typename F, typename... C>
+    static void forEachMatch(const char* p, std::size_t n, F&& f, C... wanted) {
+        std::size_t i = 0;
+        for (; i + block <= n; i += block)
+            for (std::uint32_t m = match(p + i, wanted...); m; m &= m - 1) f(i + static_cast<std::size_t>(std::countr_zero(m)));
+        if (i < n)
+            for (std::uint32_t m = matchTail(p + i, n - i, wanted...); m; m &= m - 1) f(i + static_cast<std::size_t>(std::countr_zero(m)));
+    }
+
+    // First i >= from where p[i] is one of the wanted bytes, or n
+    template <typename... C>
+    static std::size_t find(const char* p, std::size_t n, std::size_t from, C... wanted) {
+        std::size_t i = from;
+        for (; i + block <= n; i += block)
+            if (std::uint32_t m = match(p + i, wanted...)) return i + static_cast<std::size_t>(std::countr_zero(m));
+        if (i < n)
+            if (std::uint32_t m = matchTail(p + i, n - i, wanted...)) return i + static_cast<std::size_t>(std::countr_zero(m));
+        return n;
+    }
+
+    // How many of the n bytes are c (e.g. newlines, to size a vector before splitting lines)
+    static std::size_t count(const char* p, std::size_t n, char c) {
+        std::size_t total = 0, i = 0;
+        for (; i + block <= n; i += block) total += static_cast<std::size_t>(std::popcount(match(p + i, c)));
+        if (i < n) total += static_cast<std::size_t>(std::popcount(matchTail(p + i, n - i, c)));
+        return total;
+    }
+};
+
+class StringSplitter {
+public:
+    static std::string_view trim(std::string_view s) {
+        std::size_t b = 0, e = s.size();
+        while (b < e && (s[b] == ' ' || s[b] == '\t')) ++b;
+        while (e > b && (s[e - 1] == ' ' || s[e - 1] == '\t')) --e;
+        return s.substr(b, e - b);
+    }
+
+    // f(token) for every token, nothing allocated
+    template <typename F>
+    static void forEach(std::string_view s, char delim, F&& f, bool keepEmpty = true, bool trimTokens = false) {
+        std::size_t start = 0;
+        auto emit = [&](std::size_t end) {
+            std::string_view t = s.substr(start, end - start);
+            if (trimTokens) t = trim(t);
+            if (keepEmpty || !t.empty()) f(t);
+        };
+        ByteScan::forEachMatch(s.data(), s.size(), [&](std::size_t i) {
+            emit(i);
+            start = i + 1;
+        }, delim);
+        emit(s.size());
+    }
+
+    // Tokens appended to out (cleared first), returns how many
+    static std::size_t split(std::string_view s, char delim, std::vector<std::string_view>& out, bool keepEmpty = true, bool trimTokens = false) {
+        out.clear();
+        forEach(s, delim, [&](std::string_view t) { out.push_back(t); }, keepEmpty, trimTokens);
+        return out.size();
+    }
+
+    static std::vector<std::string_view> split(std::string_view s, char delim, bool keepEmpty = true, bool trimTokens = false) {
+        std::vector<std::string_view> out;
+        split(s, delim, out, keepEmpty, trimTokens);
+        return out;
+    }
+
+    // f(line) for every line, "\n" or "\r\n" endings, no empty last line after a final newline
+    template <typename F>
+    static void forEachLine(std::string_view s, F&& f) {
+        std::size_t start = 0;
+        ByteScan::forEachMatch(s.data(), s.size(), [&](std::size_t i) {
+            std::size_t end = i > start && s[i - 1] == '\r' ? i - 1 : i;
+            f(s.substr(start, end - start));
+            start = i + 1;
+        }, '\n');
+        if (start < s.size()) f(s.substr(start));
+    }
+
+    static std::vector<std::string_view> lines(std::string_view s) {
+        std::vector<std::string_view> out;
+        out.reserve(ByteScan::count(s.data(), s.size(), '\n') + 1);
+        forEachLine(s, [&](std::string_view l) { out.push_back(l); });
+        return out;
+    }
+};
@@ -0,0 +1,166 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>      // std::size_t
+#include <deque>
+#include <functional>   // std::function
+#include <memory>       // std::unique_ptr
+#include <mutex>
+#include <thread>
+#include <utility>      // std::move
+#include <vector>
+// NOT USING NAMESPACE STD FOR MORE ROBUST CODE
+
+/*
+ThreadPool (work stealing)
+    Use: Run the small fork/join tasks of the parallel Sorter modes on a fixed set of threads.
+    Steps: Start N workers → each worker owns a deque → owner pushes/pops at the back (newest first),
+           idle workers steal from the front of someone else's deque (oldest, usually the biggest job).
+    Notes:
+        - TaskGroup::wait() does not block, the waiting thread keeps running queued tasks.
+          That way nested fork/join (a task that spawns and waits on more tasks) can't deadlock the pool.
+        - Tasks must not throw, there is nobody to hand the exception to.
+*/
+
+class ThreadPool {
+private:
+    struct Worker {
+        std::mutex mtx;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+
+    std::atomic<std::size_t> queued{0};     // tasks pushed but not yet taken
+    std::atomic<std::size_t> nextQueue{0};  // round robin for pushes from outside the pool
+    std::mutex sleepMtx;
+    std::condition_variable wake;
+    bool stopping = false;
+
+    // Index of the worker the calling thread is, or npos for outside threads
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+    static std::size_t& currentIndex() {
+        thread_local std::size_t index = npos;
+        return index;
+    }
+    static ThreadPool*& currentPool() {
+        thread_local ThreadPool* pool = nullptr;
+        return pool;
+    }
+
+    bool popOwn(std::size_t i, std::function<void()>& task) {
+        Worker& w = *workers[i];
+        std::lock_guard<std::mutex> lock(w.mtx);
+        if (w.tasks.empty()) return false;
+        task = std::move(w.tasks.back());
+        w.tasks.pop_back();
+        return true;
+    }
+
+    bool steal(std::size_t start, std::function<void()>& task) {
+        for (std::size_t k = 0; k < workers.size(); ++k) {
+            Worker& w = *workers[(start + k) % workers.size()];
+            std::lock_guard<std::mutex> lock(w.mtx);
+            if (w.tasks.empty()) continue;
+            task = std::move(w.tasks.front());
+            w.tasks.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    void workerLoop(std::size_t i) {
+        currentIndex() = i;
+        currentPool()  = this;
+        while (true) {
+            if (runOne()) continue;
+
+            std::unique_lock<std::mutex> lock(sleepMtx);
+            wake.wait(lock, [this] { return stopping || queued.load() > 0; });
+            if (stopping && queued.load() == 0) return;
+        }
+    }
+
+public:
+    // 0 threads means one per hardware thread
+    explicit ThreadPool(std::size_t count = 0) {
+        if (count == 0) count = std::thread::hardware_concurrency();
+        if (count == 0) count = 1;
+
+        for (std::size_t i = 0; i < count; ++i) workers.push_back(std::make_unique<Worker>());
+        threads.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) threads.emplace_back([this, i] { workerLoop(i); });
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Finishes everything still queued, then joins
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMtx);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& t : threads) t.join();
+    }
+
+    std::size_t size() const { return threads.size(); }
+
+    void submit(std::function<void()> task) {
+        std::size_t i = currentPool() == this ? currentIndex()
+                                              : nextQueue.fetch_add(1) % workers.size();
+        {
+            std::lock_guard<std::mutex> lock(workers[i]->mtx);
+            workers[i]->tasks.push_back(std::move(task));
+        }
+        queued.fetch_add(1);
+        {
+            // taking the lock orders this with a worker that is about to sleep
+            std::lock_guard<std::mutex> lock(sleepMtx);
+        }
+        wake.notify_one();
+    }
+
+    // Runs one queued task on the calling thread. Returns false if there was nothing to run.
+    bool runOne() {
+        std::function<void()> task;
+        bool own = currentPool() == this;
+        std::size_t i = own ? currentIndex() : 0;
+        if (!(own && popOwn(i, task)) && !steal(own ? i + 1 : 0, task)) return false;
+
+        queued.fetch_sub(1);
+        task();
+        return true;
+    }
+
+    // Fork/join helper: run() any number of tasks, then wait() for all of them
+    class TaskGroup {
+    private:
+        ThreadPool& pool;
+        std::atomic<std::size_t> pending{0};
+
+    public:
+        explicit TaskGroup(ThreadPool& p) : pool(p) {}
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+        ~TaskGroup() { wait(); }
+
+        template <typename F>
+        void run(F f) {
+            pending.fetch_add(1);
+            pool.submit([this, f = std::move(f)]() mutable {
+                f();
+                pending.fetch_sub(1, std::memory_order_release);
+            });
+        }
+
+        // Helps with queued work until every task of this group is done
+        void wait() {
+            while (pending.load(std::memory_order_acquire) != 0) {
+                if (!pool.runOne()) std::this_thread::yield();
+            }
+        }
+    };
+};
@@ -0,0 +1,285 @@
+#pragma once
+#include <cstddef>      // std::size_t
+#include <cstdint>
+#include <cstdio>       // std::FILE, std::fopen
+#include <cstring>      // std::memcpy, std::memcmp
+#include <filesystem>
+#include <span>
+#include <string>
+#include <system_error>
+#include <type_traits>  // std::is_trivially_copyable_v
+#include <utility>      // std::exchange
+#include <vector>
+#include "binaryTree.h"
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define TREEFILE_MMAP 1
+#endif
+// NOT USING NAMESPACE STD FOR MORE ROBUST CODE
+
+/*
+TreeFile / MappedTree
+    Use: Save a binaryTree to disk once, then open it again in constant time and search /
+         walk it straight from the file, without reading or rebuilding anything.
+    Steps: save() packs the tree's nodes in pre-order (root at 0, links are indices into the
+           same array) → writes a 64 byte header and the node array to path.tmp → renames it
+           over path, so a reader never sees half a file.
+           MappedTree::open() maps the file read only → checks the header → the mapped node
+           array is the tree: search / visit / traverse run on it directly.
+    Notes:
+        - Nodes are the same 12 bytes as in memory (data, left, right), so "loading" is one
+          mmap and pages come in only when a walk touches them.
+        - Files are in the writer's byte order; the header has an endian marker and a
+          reader on a machine with the other order refuses the file.
+        - open() only checks the header and the file size (O(1)). verify() (or open(path, true))
+          also checks the checksum and that every child index points forward into the file,
+          which guarantees walks end. Do that for files you didn't write yourself.
+        - Trees that are sorted in order (buildFromSorted / insertSorted) are flagged in the
+          header and search them in O(log n); other trees are scanned like binaryTree::search.
+        - Without POSIX mmap (e.g. Windows) MappedTree reads the file into memory instead.
+*/
+
+struct TreeFileHeader {
+    char magic[8];                 // "BTREE\0\0\0"
+    std::uint32_t version;
+    std::uint32_t nodeSize;        // sizeof(Node)
+    std::uint64_t nodeCount;
+    std::uint32_t root;            // 0, or nilNode for an empty tree
+    std::uint32_t endianMarker;    // 0x01020304 as written by the saving machine
+    std::uint64_t checksum;        // TreeFile::checksum of the node array
+    std::uint32_t flags;           // TreeFile::searchTree
+    unsigned char reserved[20];
+};
+static_assert(sizeof(TreeFileHeader) == 64, "nodes start right after a 64 byte header");
+static_assert(std::is_trivially_copyable_v<Node> && sizeof(Node) == 12, "Node is written as raw bytes");
+
+class TreeFile {
+public:
+    static constexpr char magic[8] = { 'B', 'T', 'R', 'E', 'E', 0, 0, 0 };
+    static constexpr std::uint32_t version = 1;
+    static constexpr std::uint32_t endianMarker = 0x01020304;
+    static constexpr std::uint32_t searchTree = 1;   // in order is sorted, search can descend
+
+    // True if an in order walk gives the nodes sorted (a search tree, e.g. from buildFromSorted)
+    static bool inOrderSorted(const Node* nodes, NodeIndex root) {
+        bool first = true;
+        int last = 0;
+        return TreeWalker::visit(nodes, root, TreeOrder::in, [&](int v) {
+            if (!first && v < last) return false;
+            first = false;
+            last = v;
+            return true;
+        });
+    }
+
+    // 64 bit mix over 8 byte words (the tail is zero padded). Cheap, and any flipped
+    // or swapped word changes it; not meant to stop someone forging a file.
+    static std::uint64_t checksum(const void* data, std::size_t bytes) {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        std::uint64_t h = 0x9e3779b97f4a7c15ull ^ bytes;
+        for (std::size_t i = 0; i < bytes; i += 8) {
+            std::uint64_t word = 0;
+            std::memcpy(&word, p + i, bytes - i < 8 ? bytes - i : 8);
+            h ^= word * 0xff51afd7ed558ccdull;
+            h = ((h << 31) | (h >> 33)) * 0xc4ceb9fe1a85ec53ull;
+        }
+        return h ^ (h >> 29);
+    }
+
+    // Writes tree to path. Returns false if the file couldn't be written (path is then untouched).
+    static bool save(const binaryTree& tree, const std::string& path) {
+        std::vector<Node> nodes = tree.packedNodes();
+
+        TreeFileHeader header{};
+        std::memcpy(header.magic, magic, sizeof(magic));
+        header.version = version;
+        header.nodeSize = sizeof(Node);
+        header.nodeCount = nodes.size();
+        header.root = nodes.empty() ? nilNode : 0;
+        header.endianMarker = endianMarker;
+        header.checksum = checksum(nodes.data(), nodes.size() * sizeof(Node));
+        header.flags = inOrderSorted(nodes.data(), header.root) ? searchTree : 0;
+
+        std::string tmp = path + ".tmp";
+        std::FILE* f = std::fopen(tmp.c_str(), "wb");
+        if (!f) return false;
+        bool ok = std::fwrite(&header, sizeof(header), 1, f) == 1 &&
+                  (nodes.empty() || std::fwrite(nodes.data(), sizeof(Node), nodes.size(), f) == nodes.size());
+        ok = (std::fclose(f) == 0) && ok;
+
+        std::error_code ec;
+        if (ok) std::filesystem::rename(tmp, path, ec);
+        if (!ok || ec) {
+            std::filesystem::remove(tmp, ec);
+            return false;
+        }
+        return true;
+    }
+};
+
+// Read only binaryTree backed by a saved file
+class MappedTree {
+private:
+    const unsigned char* base = nullptr;   // whole file
+    std::size_t fileSize = 0;
+    std::vector<std::uint64_t> buffer;     // file contents when there is no mmap
+    bool mapped = false;
+    const char* lastError = nullptr;
+
+    const TreeFileHeader& header() const { return *reinterpret_cast<const TreeFileHeader*>(base); }
+    const Node* nodes() const { return reinterpret_cast<const Node*>(base + sizeof(TreeFileHeader)); }
+    NodeIndex root() const { return base ? header().root : nilNode; }
+
+    bool fail(const char* why) {
+        close();
+        lastError = why;
+        return false;
+    }
+
+    bool load(const std::string& path) {
+#ifdef TREEFILE_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return fail("can't open file");
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            return fail("can't stat file");
+        }
+        fileSize = static_cast<std::size_t>(st.st_size);
+        if (fileSize < sizeof(TreeFileHeader)) {
+            ::close(fd);
+            return fail("file too small");
+        }
+        void* p = ::mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);   // the mapping keeps the file open
+        if (p == MAP_FAILED) return fail("mmap failed");
+        base = static_cast<const unsigned char*>(p);
+        mapped = true;
+        return true;
+#else
+        std::FILE* f = std::fopen(path.c_str(), "rb");
+        if (!f) return fail("can't open file");
+        std::error_code ec;
+        fileSize = static_cast<std::size_t>(std::filesystem::file_size(path, ec));
+        if (ec || fileSize < sizeof(TreeFileHeader)) {
+            std::fclose(f);
+            return fail("file too small");
+        }
+        buffer.resize((fileSize + 7) / 8);
+        bool ok = std::fread(buffer.data(), 1, fileSize, f) == fileSize;
+        std::fclose(f);
+        if (!ok) return fail("can't read file");
+        base = reinterpret_cast<const unsigned char*>(buffer.data());
+        return true;
+#endif
+    }
+
+public:
+    MappedTree() = default;
+    explicit MappedTree(const std::string& path, bool verifyAll = false) { open(path, verifyAll); }
+    ~MappedTree() { close(); }
+
+    MappedTree(const MappedTree&) = delete;
+    MappedTree& operator=(const MappedTree&) = delete;
+    MappedTree(MappedTree&& o) noexcept { *this = std::move(o); }
+    MappedTree& operator=(MappedTree&& o) noexcept {
+        if (this != &o) {
+            close();
+            base = std::exchange(o.base, nullptr);
+            fileSize = std::exchange(o.fileSize, 0);
+            buffer = std::move(o.buffer);
+            mapped = std::exchange(o.mapped, false);
+            lastError = o.lastError;
+        }
+        return *this;
+    }
+
+    // Maps path and checks its header (plus verify() when verifyAll is set).
+    // Returns false and leaves the tree empty on any problem, error() says what.
+    bool open(const std::string& path, bool verifyAll = false) {
+        close();
+        lastError = nullptr;
+        if (!load(path)) return false;
+
+        const TreeFileHeader& h = header();
+        if (std::memcmp(h.magic, TreeFile::magic, sizeof(h.magic)) != 0) return fail("not a tree file");
+        if (h.endianMarker != TreeFile::endianMarker) return fail("file has the other byte order");
+        if (h.version != TreeFile::version) return fail("unknown version");
+        if (h.nodeSize != sizeof(Node)) return fail("node size mismatch");
+        if (h.nodeCount > (fileSize - sizeof(TreeFileHeader)) / sizeof(Node) ||
+            fileSize != sizeof(TreeFileHeader) + h.nodeCount * sizeof(Node)) return fail("file size doesn't match node count");
+        if (h.nodeCount == 0 ? h.root != nilNode : h.root != 0) return fail("bad root");
+        if (verifyAll && !verify()) return false;
+        return true;
+    }
+
+    void close() {
+#ifdef TREEFILE_MMAP
+        if (mapped) ::munmap(const_cast<unsigned char*>(base), fileSize);
+#endif
+        base = nullptr;
+        fileSize = 0;
+        buffer.clear();
+        mapped = false;
+    }
+
+    // O(n) check of the checksum and of every link (children come after their parent
+    // and inside the file, so no walk can loop or run off the end), and of the search tree flag
+    bool verify() {
+        if (!base) return false;
+        std::size_t count = size();
+        if (TreeFile::checksum(nodes(), count * sizeof(Node)) != header().checksum) return fail("checksum mismatch");
+        const Node* n = nodes();
+        for (std::size_t i = 0; i < count; ++i) {
+            for (NodeIndex child : { n[i].left, n[i].right }) {
+                if (child != nilNode && (child <= i || child >= count)) return fail("bad child index");
+            }
+        }
+        if ((header().flags & TreeFile::searchTree) && !TreeFile::inOrderSorted(n, root())) return fail("search tree flag on unsorted tree");
+        return true;
+    }
+
+    bool isOpen() const { return base != nullptr; }
+    const char* error() const { return lastError; }
+    std::size_t size() const { return base ? static_cast<std::size_t>(header().nodeCount) : 0; }
+
+    // The node array as saved: pre-order, root at 0
+    std::span<const Node> nodeArray() const { return { base ? nodes() : nullptr, size() }; }
+
+    bool isSearchTree() const { return base && (header().flags & TreeFile::searchTree); }
+
+    // Same answer as binaryTree::search. A search tree (sorted in order) is descended,
+    // O(log n) for a balanced one. Anything else is a straight scan of the array, every
+    // node in the file is part of the tree so no walk is needed.
+    bool search(int value) const {
+        if (isSearchTree()) {
+            const Node* n = nodes();
+            for (NodeIndex i = root(); i != nilNode;) {
+                if (value == n[i].data) return true;
+                i = value < n[i].data ? n[i].left : n[i].right;
+            }
+            return false;
+        }
+        for (const Node& n : nodeArray()) {
+            if (n.data == value) return true;
+        }
+        return false;
+    }
+
+    // Same as binaryTree::visit / traverse, on the mapped nodes
+    template <typename F>
+    bool visit(TreeOrder order, F&& f) const {
+        return TreeWalker::visit(base ? nodes() : nullptr, root(), order, f);
+    }
+    TreeTraversal traverse(TreeOrder order) const { return { base ? nodes() : nullptr, root(), order }; }
+
+    // Editable copy in memory
+    binaryTree toTree() const {
+        binaryTree tree;
+        tree.assignPacked(nodeArray());
+        return tree;
+    }
+};